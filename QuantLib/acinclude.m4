@@ -154,6 +154,40 @@ AC_DEFUN([QL_CHECK_BOOST_UNIT_TEST],
  fi
 ])
 
+# QL_CHECK_BOOST_THREAD
+# ---------------------
+# Check whether the Boost thread library is available and add it
+# to the libraries to link with
+AC_DEFUN([QL_CHECK_BOOST_THREAD],
+[AC_MSG_CHECKING([for Boost thread library])
+ AC_REQUIRE([AC_PROG_CC])
+ ql_original_LIBS=$LIBS
+ boost_thread_found=no
+ for boost_lib in boost_thread boost_thread-mt ; do
+     for boost_extra_libs in "" "-lboost_system" "-lboost_system-mt" ; do
+         LIBS="$ql_original_LIBS -l$boost_lib $boost_extra_libs"
+         AC_LINK_IFELSE([AC_LANG_SOURCE(
+             [@%:@include <boost/thread/tss.hpp>
+              int main() {
+                  boost::thread_specific_ptr<int> p;
+                  p.reset(new int(0));
+                  return *p;
+              }
+             ])],
+             [boost_thread_found="-l$boost_lib $boost_extra_libs"
+              break 2],
+             [])
+     done
+ done
+ if test "$boost_thread_found" = no ; then
+     LIBS="$ql_original_LIBS"
+     AC_MSG_RESULT([no])
+     AC_MSG_ERROR([Boost thread library not found])
+ else
+     AC_MSG_RESULT([yes])
+ fi
+])
+
 # QL_CHECK_BOOST_TEST_STREAM
 # --------------------------
 # Check whether Boost unit-test stream accepts std::fixed
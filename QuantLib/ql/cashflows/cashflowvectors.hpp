@@ -36,6 +36,7 @@
 #include <ql/utilities/vectors.hpp>
 #include <ql/position.hpp>
 #include <ql/indexes/swapindex.hpp>
+#include <boost/make_shared.hpp>
 
 namespace QuantLib {
 
@@ -111,13 +112,13 @@ namespace QuantLib {
                 refEnd = calendar.adjust(start + schedule.tenor(), bdc);
             }
             if (detail::get(gearings, i, 1.0) == 0.0) { // fixed coupon
-                leg.push_back(boost::shared_ptr<CashFlow>(new
-                    FixedRateCoupon(paymentDate,
+                leg.push_back(boost::make_shared<FixedRateCoupon>(
+                                    paymentDate,
                                     detail::get(nominals, i, 1.0),
                                     detail::effectiveFixedRate(spreads,caps,
                                                                floors,i),
                                     paymentDayCounter,
-                                    start, end, refStart, refEnd)));
+                                    start, end, refStart, refEnd));
             } else { // floating coupon
                 if (detail::noOption(caps, floors, i))
                     leg.push_back(boost::shared_ptr<CashFlow>(new
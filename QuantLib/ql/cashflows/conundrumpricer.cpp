@@ -23,6 +23,7 @@
 
 #include <ql/cashflows/conundrumpricer.hpp>
 #include <ql/math/integrals/kronrodintegral.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/math/solvers1d/newton.hpp>
@@ -61,6 +62,15 @@ namespace QuantLib {
             forwardValue_, std::sqrt(variance));
     }
 
+    void VanillaOptionPricer::prices(const std::vector<Real>& strikes,
+                                     Option::Type optionType,
+                                     Real deflator,
+                                     std::vector<Real>& results) const {
+        results.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            results[i] = (*this)(strikes[i], optionType, deflator);
+    }
+
 
 //===========================================================================//
 //                             HaganPricer                               //
@@ -97,51 +107,145 @@ namespace QuantLib {
 
         spreadLegValue_ = spread_ * accrualPeriod * discount_;
 
+        paymentData_ = 0;
         if (fixingDate_ > today){
             swapTenor_ = swapIndex->tenor();
-            boost::shared_ptr<VanillaSwap> swap = swapIndex->underlyingSwap(fixingDate_);
-
-            swapRateValue_ = swap->fairRate();
-
-            static const Spread bp = 1.0e-4;
-            annuity_ = (swap->floatingLegBPS()/bp);
-
-            Size q = swapIndex->fixedLegTenor().frequency();
-            const Schedule& schedule = swap->fixedSchedule();
-            const DayCounter& dc = swapIndex->dayCounter();
-            //const DayCounter dc = coupon.dayCounter();
-            Time startTime = dc.yearFraction(rateCurve_->referenceDate(),
-                                             swap->startDate());
-            Time swapFirstPaymentTime =
-                dc.yearFraction(rateCurve_->referenceDate(), schedule.date(1));
-            Time paymentTime = dc.yearFraction(rateCurve_->referenceDate(),
-                                               paymentDate_);
-            Real delta = (paymentTime-startTime) / (swapFirstPaymentTime-startTime);
-
-            switch (modelOfYieldCurve_) {
-                case GFunctionFactory::Standard:
-                    gFunction_ = GFunctionFactory::newGFunctionStandard(q, delta, swapTenor_.length());
-                    break;
-                case GFunctionFactory::ExactYield:
-                    gFunction_ = GFunctionFactory::newGFunctionExactYield(*coupon_);
-                    break;
-                case GFunctionFactory::ParallelShifts: {
-                    Handle<Quote> nullMeanReversionQuote(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
-                    gFunction_ = GFunctionFactory::newGFunctionWithShifts(*coupon_, nullMeanReversionQuote);
-                    }
-                    break;
-                case GFunctionFactory::NonParallelShifts:
-                    gFunction_ = GFunctionFactory::newGFunctionWithShifts(*coupon_, meanReversion_);
-                    break;
-                default:
-                    QL_FAIL("unknown/illegal gFunction type");
+            FixingData& data = fixingData(swapIndex);
+
+            swapRateValue_ = data.swapRateValue;
+            annuity_ = data.annuity;
+            variance_ = data.variance;
+
+            paymentData_ = &data.payments[paymentDate_];
+            if (!paymentData_->gFunction) {
+                Size q = swapIndex->fixedLegTenor().frequency();
+                const DayCounter& dc = swapIndex->dayCounter();
+                //const DayCounter dc = coupon.dayCounter();
+                Time startTime = data.startTime;
+                Time swapFirstPaymentTime = data.firstPaymentTime;
+                Time paymentTime = dc.yearFraction(rateCurve_->referenceDate(),
+                                                   paymentDate_);
+                Real delta = (paymentTime-startTime) / (swapFirstPaymentTime-startTime);
+
+                boost::shared_ptr<GFunction>& g = paymentData_->gFunction;
+                switch (modelOfYieldCurve_) {
+                    case GFunctionFactory::Standard:
+                        g = GFunctionFactory::newGFunctionStandard(q, delta, swapTenor_.length());
+                        break;
+                    case GFunctionFactory::ExactYield:
+                        g = GFunctionFactory::newGFunctionExactYield(*coupon_);
+                        break;
+                    case GFunctionFactory::ParallelShifts: {
+                        Handle<Quote> nullMeanReversionQuote(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+                        g = GFunctionFactory::newGFunctionWithShifts(*coupon_, nullMeanReversionQuote);
+                        }
+                        break;
+                    case GFunctionFactory::NonParallelShifts:
+                        g = GFunctionFactory::newGFunctionWithShifts(*coupon_, meanReversion_);
+                        break;
+                    default:
+                        QL_FAIL("unknown/illegal gFunction type");
+                }
             }
-            vanillaOptionPricer_= boost::shared_ptr<VanillaOptionPricer>(new
-                BlackVanillaOptionPricer(swapRateValue_, fixingDate_, swapTenor_,
-                                        *swaptionVolatility()));
+            gFunction_ = paymentData_->gFunction;
+            vanillaOptionPricer_= data.vanillaOptionPricer;
          }
     }
 
+    HaganPricer::FixingData& HaganPricer::fixingData(
+                        const boost::shared_ptr<SwapIndex>& swapIndex) {
+        Date today = Settings::instance().evaluationDate();
+        if (today != fixingDataEvaluationDate_) {
+            clearFixingData();
+            fixingDataEvaluationDate_ = today;
+        }
+
+        // the key holds the index, so that its address can't be
+        // reused by another one while the data are stored
+        fixing_key key(swapIndex, fixingDate_);
+        fixing_data_map::iterator i = fixingData_.find(key);
+        if (i != fixingData_.end()) {
+            fixingUsage_.splice(fixingUsage_.begin(), fixingUsage_,
+                                i->second.use);
+            return i->second;
+        }
+
+        if (fixingData_.size() >= maxCachedFixings) {
+            fixing_key last = fixingUsage_.back();
+            fixingUsage_.pop_back();
+            fixingData_.erase(last);
+            forget(last.first);
+        }
+
+        FixingData data;
+        boost::shared_ptr<VanillaSwap> swap =
+            swapIndex->underlyingSwap(fixingDate_);
+
+        data.swapRateValue = swap->fairRate();
+
+        static const Spread bp = 1.0e-4;
+        data.annuity = (swap->floatingLegBPS()/bp);
+
+        const Schedule& schedule = swap->fixedSchedule();
+        const DayCounter& dc = swapIndex->dayCounter();
+        data.startTime = dc.yearFraction(rateCurve_->referenceDate(),
+                                         swap->startDate());
+        data.firstPaymentTime =
+            dc.yearFraction(rateCurve_->referenceDate(), schedule.date(1));
+
+        data.variance = swaptionVolatility()->blackVariance(
+                               fixingDate_, swapTenor_, data.swapRateValue);
+        data.vanillaOptionPricer = boost::shared_ptr<VanillaOptionPricer>(new
+            BlackVanillaOptionPricer(data.swapRateValue, fixingDate_,
+                                     swapTenor_, *swaptionVolatility()));
+
+        observe(swapIndex);
+        data.use = fixingUsage_.insert(fixingUsage_.begin(), key);
+        return fixingData_[key] = data;
+    }
+
+    void HaganPricer::clearFixingData() {
+        std::map<boost::shared_ptr<Observable>, Size>::iterator i;
+        for (i = observed_.begin(); i != observed_.end(); ++i)
+            unregisterWith(i->first);
+        observed_.clear();
+        fixingData_.clear();
+        fixingUsage_.clear();
+    }
+
+    void HaganPricer::observe(const boost::shared_ptr<SwapIndex>& swapIndex) {
+        // the index forwards the notifications of its forwarding
+        // curve, but not those of its discount curve
+        observe(boost::shared_ptr<Observable>(swapIndex));
+        if (swapIndex->exogenousDiscount())
+            observe(swapIndex->discountingTermStructure());
+    }
+
+    void HaganPricer::observe(const boost::shared_ptr<Observable>& o) {
+        if (observed_[o]++ == 0)
+            registerWith(o);
+    }
+
+    void HaganPricer::forget(const boost::shared_ptr<SwapIndex>& swapIndex) {
+        forget(boost::shared_ptr<Observable>(swapIndex));
+        if (swapIndex->exogenousDiscount())
+            forget(swapIndex->discountingTermStructure());
+    }
+
+    void HaganPricer::forget(const boost::shared_ptr<Observable>& o) {
+        std::map<boost::shared_ptr<Observable>, Size>::iterator i =
+            observed_.find(o);
+        if (i != observed_.end() && --(i->second) == 0) {
+            unregisterWith(o);
+            observed_.erase(i);
+        }
+    }
+
+    void HaganPricer::update() {
+        clearFixingData();
+        CmsCouponPricer::update();
+    }
+
     Real HaganPricer::meanReversion() const { return meanReversion_->value();}
 
     Rate HaganPricer::swapletRate() const {
@@ -245,7 +349,8 @@ namespace QuantLib {
         const Handle<Quote>& meanReversion,
         Real lowerLimit,
         Real upperLimit,
-        Real precision)
+        Real precision,
+        Size quadratureOrder)
     : HaganPricer(swaptionVol, modelOfYieldCurve, meanReversion),
        upperLimit_(upperLimit),
        lowerLimit_(lowerLimit),
@@ -253,10 +358,61 @@ namespace QuantLib {
        precision_(precision),
        refiningIntegrationTolerance_(.0001){
 
+        if (quadratureOrder > 0) {
+            GaussLegendreIntegration quadrature(quadratureOrder);
+            nodes_.resize(quadratureOrder);
+            weights_.resize(quadratureOrder);
+            for (Size i=0; i<quadratureOrder; ++i) {
+                nodes_[i] = 0.5*(quadrature.x()[i]+1.0);
+                weights_[i] = 0.5*quadrature.weights()[i];
+            }
+        }
+    }
+
+    Real NumericHaganPricer::integrateOnFixedNodes(Real a,
+        Real b, const ConundrumIntegrand& integrand) const {
+
+        Real upperBoundary = b;
+        Size k = 1;
+        if (a>0) {
+            // same boundary estimation as in the adaptive case
+            upperBoundary = 2*a;
+            while(integrand(upperBoundary)>precision_)
+                upperBoundary *=2.0;
+            if (b > a)
+                upperBoundary = std::min(upperBoundary, b);
+            // same change of variable as well
+            if (upperBoundary > 2*a)
+                k = 3;
+        }
+
+        // x = a + (b-a)*t^k, t in [0,1]
+        const Real width = upperBoundary - a;
+        const Size n = nodes_.size();
+        std::vector<Real> x(n), jacobian(n);
+        for (Size i=0; i<n; ++i) {
+            Real temp = width;
+            for (Size j=1; j<k; ++j)
+                temp *= nodes_[i];
+            x[i] = a + nodes_[i]*temp;
+            jacobian[i] = weights_[i]*k*temp;
+        }
+
+        std::vector<Real> options;
+        integrand.vanillaOptionPricer_->prices(x, integrand.optionType_,
+                                               integrand.annuity_, options);
+        Real result = 0.0;
+        for (Size i=0; i<n; ++i)
+            result += options[i]*integrand.secondDerivativeOfF(x[i])
+                    * jacobian[i];
+        return result;
     }
 
     Real NumericHaganPricer::integrate(Real a,
         Real b, const ConundrumIntegrand& integrand) const {
+            if (!nodes_.empty())
+                return integrateOnFixedNodes(a, b, integrand);
+
             double result =.0;
             //double abserr =.0;
             //double alpha = 1.0;
@@ -348,10 +504,17 @@ namespace QuantLib {
             Rate price = (gearing_*Rs + spread_)*(coupon_->accrualPeriod()*discount_);
             return price;
         } else {
-            Real atmCapletPrice = optionletPrice(Option::Call, swapRateValue_);
-            Real atmFloorletPrice = optionletPrice(Option::Put, swapRateValue_);
-            return gearing_ *(coupon_->accrualPeriod()* discount_ * swapRateValue_
-                             + atmCapletPrice - atmFloorletPrice)
+            Real accrualPeriod = coupon_->accrualPeriod();
+            Real& adjustment = paymentData_->swapletAdjustment;
+            if (adjustment == Null<Real>()) {
+                Real atmCapletPrice =
+                    optionletPrice(Option::Call, swapRateValue_);
+                Real atmFloorletPrice =
+                    optionletPrice(Option::Put, swapRateValue_);
+                adjustment = (atmCapletPrice - atmFloorletPrice)/accrualPeriod;
+            }
+            return gearing_ *(accrualPeriod* discount_ * swapRateValue_
+                             + adjustment*accrualPeriod)
                    + spreadLegValue_;
         }
     }
@@ -373,10 +536,8 @@ namespace QuantLib {
     Real NumericHaganPricer::resetUpperLimit(
                         Real stdDeviationsForUpperLimit) const {
         //return 1.0;
-        Real variance =
-            swaptionVolatility()->blackVariance(fixingDate_,swapTenor_,swapRateValue_);
         return swapRateValue_ *
-            std::exp(stdDeviationsForUpperLimit*std::sqrt(variance));
+            std::exp(stdDeviationsForUpperLimit*std::sqrt(variance_));
     }
 
 
@@ -456,9 +617,7 @@ namespace QuantLib {
     //Hagan, 3.5b, 3.5c
     Real AnalyticHaganPricer::optionletPrice(Option::Type optionType,
                                                   Real strike) const {
-        Real variance = swaptionVolatility()->blackVariance(fixingDate_,
-                                                           swapTenor_,
-                                                           swapRateValue_);
+        Real variance = variance_;
         Real firstDerivativeOfGAtForwardValue = gFunction_->firstDerivative(
                                                         swapRateValue_);
         Real price = 0;
@@ -493,9 +652,7 @@ namespace QuantLib {
             Rate price = (gearing_*Rs + spread_)*(coupon_->accrualPeriod()*discount_);
             return price;
         } else {
-            Real variance(swaptionVolatility()->blackVariance(fixingDate_,
-                                                               swapTenor_,
-                                                               swapRateValue_));
+            Real variance(variance_);
             Real firstDerivativeOfGAtForwardValue(gFunction_->firstDerivative(
                                                             swapRateValue_));
             Real price = 0;
@@ -25,12 +25,15 @@
 
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
     class CmsCoupon;
     class YieldTermStructure;
     class Quote;
+    class SwapIndex;
 
     class VanillaOptionPricer {
       public:
@@ -38,6 +41,13 @@ namespace QuantLib {
         virtual Real operator()(Real strike,
                                 Option::Type optionType,
                                 Real deflator) const = 0;
+        /*! prices for a set of strikes; the default implementation
+            calls operator() for each of them.
+        */
+        virtual void prices(const std::vector<Real>& strikes,
+                            Option::Type optionType,
+                            Real deflator,
+                            std::vector<Real>& results) const;
     };
 
     class BlackVanillaOptionPricer : public VanillaOptionPricer {
@@ -195,6 +205,18 @@ namespace QuantLib {
     //! CMS-coupon pricer
     /*! Base class for the pricing of a CMS coupon via static replication
         as in Hagan's "Conundrums..." article
+
+        The underlying swap rate, annuity and smile section depend
+        only on the fixing date and on the swap index; the
+        g-function and the replication integrals for the swaplet
+        depend on the payment date as well.  They are cached, so
+        that coupons (or caplets and floorlets at different strikes)
+        sharing them don't calculate them again.  The cache is
+        cleared whenever the pricer is notified of a change,
+        including changes in the curves of the swap indexes; the
+        data for the least recently used fixing are discarded when
+        the data for maxCachedFixings are stored.  The pricer only
+        observes the swap indexes for which it holds data.
     */
     class HaganPricer: public CmsCouponPricer {
       public:
@@ -213,6 +235,8 @@ namespace QuantLib {
             registerWith(meanReversion_);
             update();
         };
+        /* */
+        void update();
       protected:
         HaganPricer(
                 const Handle<SwaptionVolatilityStructure>& swaptionVol,
@@ -238,6 +262,44 @@ namespace QuantLib {
         Handle<Quote> meanReversion_;
         Period swapTenor_;
         boost::shared_ptr<VanillaOptionPricer> vanillaOptionPricer_;
+        Real variance_;
+        struct PaymentData {
+            PaymentData() : swapletAdjustment(Null<Real>()) {}
+            boost::shared_ptr<GFunction> gFunction;
+            // difference between the at-the-money caplet and
+            // floorlet prices for a unit accrual period, once
+            // calculated by the derived class
+            Real swapletAdjustment;
+        };
+        // data for the fixing and payment dates of the coupon
+        PaymentData* paymentData_;
+      private:
+        typedef std::pair<boost::shared_ptr<SwapIndex>, Date> fixing_key;
+        typedef std::list<fixing_key> fixing_usage;
+        struct FixingData {
+            Rate swapRateValue;
+            Real annuity;
+            Time startTime, firstPaymentTime;
+            Real variance;
+            boost::shared_ptr<VanillaOptionPricer> vanillaOptionPricer;
+            std::map<Date, PaymentData> payments;
+            fixing_usage::iterator use;
+        };
+        FixingData& fixingData(const boost::shared_ptr<SwapIndex>& swapIndex);
+        void clearFixingData();
+        // register with the index and its discount curve, if any
+        void observe(const boost::shared_ptr<SwapIndex>& swapIndex);
+        void observe(const boost::shared_ptr<Observable>&);
+        // unregister when no cached fixing depends on them
+        void forget(const boost::shared_ptr<SwapIndex>& swapIndex);
+        void forget(const boost::shared_ptr<Observable>&);
+        typedef std::map<fixing_key, FixingData> fixing_data_map;
+        static const Size maxCachedFixings = 1000;
+        fixing_data_map fixingData_;
+        fixing_usage fixingUsage_;
+        // number of cached fixings depending on each observable
+        std::map<boost::shared_ptr<Observable>, Size> observed_;
+        Date fixingDataEvaluationDate_;
     };
 
 
@@ -245,6 +307,18 @@ namespace QuantLib {
     /*! Prices a cms coupon via static replication as in Hagan's
         "Conundrums..." article via numerical integration based on
         prices of vanilla swaptions
+
+        By default, the replication integrals are computed with an
+        adaptive Gauss-Kronrod scheme.  If a non-null quadrature
+        order is passed, they are computed instead with a
+        Gauss-Legendre rule of that order; in this case, the
+        swaption prices at all the nodes are requested from the
+        vanilla-option pricer at once.
+
+        \warning the rule doesn't adapt to the integrand; smiles
+                 which are not smooth in the strike, such as the ones
+                 interpolated from a swaption cube, might require
+                 higher orders for the same accuracy.
     */
     class NumericHaganPricer : public HaganPricer {
       public:
@@ -254,7 +328,8 @@ namespace QuantLib {
             const Handle<Quote>& meanReversion,
             Rate lowerLimit = 0.0,
             Rate upperLimit = 1.0,
-            Real precision = 1.0e-6);
+            Real precision = 1.0e-6,
+            Size quadratureOrder = 0);
 
        Real upperLimit() { return upperLimit_; }
        Real stdDeviations() { return stdDeviationsForUpperLimit_; }
@@ -301,6 +376,9 @@ namespace QuantLib {
         Real integrate(Real a,
                        Real b,
                        const ConundrumIntegrand& Integrand) const;
+        Real integrateOnFixedNodes(Real a,
+                                   Real b,
+                                   const ConundrumIntegrand& Integrand) const;
         virtual Real optionletPrice(Option::Type optionType,
                                     Rate strike) const;
         virtual Real swapletPrice() const;
@@ -309,6 +387,8 @@ namespace QuantLib {
 
         mutable Real upperLimit_, stdDeviationsForUpperLimit_;
         const Real lowerLimit_, requiredStdDeviations_, precision_, refiningIntegrationTolerance_;
+        // Gauss-Legendre nodes and weights rescaled to [0,1]
+        std::vector<Real> nodes_, weights_;
     };
 
     //! CMS-coupon pricer
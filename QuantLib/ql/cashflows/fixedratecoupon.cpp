@@ -21,6 +21,7 @@
 */
 
 #include <ql/cashflows/fixedratecoupon.hpp>
+#include <boost/make_shared.hpp>
 
 using boost::shared_ptr;
 using std::vector;
@@ -71,7 +72,11 @@ namespace QuantLib {
 
 
     FixedRateLeg::FixedRateLeg(const Schedule& schedule)
-    : schedule_(schedule), calendar_(schedule.calendar()),
+    : schedule_(new Schedule(schedule)), calendar_(schedule.calendar()),
+      paymentAdjustment_(Following) {}
+
+    FixedRateLeg::FixedRateLeg(const shared_ptr<const Schedule>& schedule)
+    : schedule_(schedule), calendar_(schedule->calendar()),
       paymentAdjustment_(Following) {}
 
     FixedRateLeg& FixedRateLeg::withNotionals(Real notional) {
@@ -138,38 +143,35 @@ namespace QuantLib {
         QL_REQUIRE(!notionals_.empty(), "no notional given");
 
         Leg leg;
-        leg.reserve(schedule_.size()-1);
+        leg.reserve(schedule_->size()-1);
 
-        Calendar schCalendar = schedule_.calendar();
+        Calendar schCalendar = schedule_->calendar();
 
         // first period might be short or long
-        Date start = schedule_.date(0), end = schedule_.date(1);
+        Date start = schedule_->date(0), end = schedule_->date(1);
         Date paymentDate = calendar_.adjust(end, paymentAdjustment_);
         InterestRate rate = couponRates_[0];
         Real nominal = notionals_[0];
-        if (schedule_.isRegular(1)) {
+        if (schedule_->isRegular(1)) {
             QL_REQUIRE(firstPeriodDC_.empty() ||
                        firstPeriodDC_ == rate.dayCounter(),
                        "regular first coupon "
                        "does not allow a first-period day count");
-            shared_ptr<CashFlow> temp(new
-                FixedRateCoupon(paymentDate, nominal, rate,
-                                start, end, start, end));
-            leg.push_back(temp);
+            leg.push_back(boost::make_shared<FixedRateCoupon>(
+                paymentDate, nominal, rate, start, end, start, end));
         } else {
-            Date ref = end - schedule_.tenor();
-            ref = schCalendar.adjust(ref, schedule_.businessDayConvention());
+            Date ref = end - schedule_->tenor();
+            ref = schCalendar.adjust(ref, schedule_->businessDayConvention());
             InterestRate r(rate.rate(),
                            firstPeriodDC_.empty() ? rate.dayCounter()
                                                   : firstPeriodDC_,
                            rate.compounding(), rate.frequency());
-            leg.push_back(shared_ptr<CashFlow>(new
-                FixedRateCoupon(paymentDate, nominal, r,
-                                start, end, ref, end)));
+            leg.push_back(boost::make_shared<FixedRateCoupon>(
+                paymentDate, nominal, r, start, end, ref, end));
         }
         // regular periods
-        for (Size i=2; i<schedule_.size()-1; ++i) {
-            start = end; end = schedule_.date(i);
+        for (Size i=2; i<schedule_->size()-1; ++i) {
+            start = end; end = schedule_->date(i);
             paymentDate = calendar_.adjust(end, paymentAdjustment_);
             if ((i-1) < couponRates_.size())
                 rate = couponRates_[i-1];
@@ -179,14 +181,13 @@ namespace QuantLib {
                 nominal = notionals_[i-1];
             else
                 nominal = notionals_.back();
-            leg.push_back(shared_ptr<CashFlow>(new
-                FixedRateCoupon(paymentDate, nominal, rate,
-                                start, end, start, end)));
+            leg.push_back(boost::make_shared<FixedRateCoupon>(
+                paymentDate, nominal, rate, start, end, start, end));
         }
-        if (schedule_.size() > 2) {
+        if (schedule_->size() > 2) {
             // last period might be short or long
-            Size N = schedule_.size();
-            start = end; end = schedule_.date(N-1);
+            Size N = schedule_->size();
+            start = end; end = schedule_->date(N-1);
             paymentDate = calendar_.adjust(end, paymentAdjustment_);
             if ((N-2) < couponRates_.size())
                 rate = couponRates_[N-2];
@@ -196,16 +197,14 @@ namespace QuantLib {
                 nominal = notionals_[N-2];
             else
                 nominal = notionals_.back();
-            if (schedule_.isRegular(N-1)) {
-                leg.push_back(shared_ptr<CashFlow>(new
-                    FixedRateCoupon(paymentDate, nominal, rate,
-                                    start, end, start, end)));
+            if (schedule_->isRegular(N-1)) {
+                leg.push_back(boost::make_shared<FixedRateCoupon>(
+                    paymentDate, nominal, rate, start, end, start, end));
             } else {
-                Date ref = start + schedule_.tenor();
-                ref = schCalendar.adjust(ref, schedule_.businessDayConvention());
-                leg.push_back(shared_ptr<CashFlow>(new
-                    FixedRateCoupon(paymentDate, nominal, rate,
-                                    start, end, start, ref)));
+                Date ref = start + schedule_->tenor();
+                ref = schCalendar.adjust(ref, schedule_->businessDayConvention());
+                leg.push_back(boost::make_shared<FixedRateCoupon>(
+                    paymentDate, nominal, rate, start, end, start, ref));
             }
         }
         return leg;
@@ -80,6 +80,10 @@ namespace QuantLib {
     class FixedRateLeg {
       public:
         FixedRateLeg(const Schedule& schedule);
+        /*! The schedule is shared and not copied; this allows
+            legs to use the schedules stored in the ScheduleCache.
+        */
+        FixedRateLeg(const boost::shared_ptr<const Schedule>& schedule);
         FixedRateLeg& withNotionals(Real);
         FixedRateLeg& withNotionals(const std::vector<Real>&);
         FixedRateLeg& withCouponRates(Rate,
@@ -97,7 +101,7 @@ namespace QuantLib {
         FixedRateLeg& withPaymentCalendar(const Calendar&);
         operator Leg() const;
       private:
-        Schedule schedule_;
+        boost::shared_ptr<const Schedule> schedule_;
         Calendar calendar_;
         std::vector<Real> notionals_;
         std::vector<InterestRate> couponRates_;
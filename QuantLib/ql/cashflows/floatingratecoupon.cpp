@@ -55,7 +55,6 @@ namespace QuantLib {
             dayCounter_ = index_->dayCounter();
 
         registerWith(index_);
-        registerWith(Settings::instance().evaluationDate());
     }
 
     void FloatingRateCoupon::setPricer(
@@ -93,6 +93,10 @@ namespace QuantLib {
 
         //! \name Observer interface
         //@{
+        /*! Changes of the evaluation date are not observed,
+            nor received through the index; the instruments holding
+            the coupon must register with the evaluation date.
+        */
         void update() { notifyObservers(); }
         //@}
 
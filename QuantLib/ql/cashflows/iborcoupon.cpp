@@ -130,6 +130,12 @@ namespace QuantLib {
 
     IborLeg::IborLeg(const Schedule& schedule,
                      const shared_ptr<IborIndex>& index)
+    : schedule_(new Schedule(schedule)), index_(index),
+      paymentAdjustment_(Following),
+      inArrears_(false), zeroPayments_(false) {}
+
+    IborLeg::IborLeg(const shared_ptr<const Schedule>& schedule,
+                     const shared_ptr<IborIndex>& index)
     : schedule_(schedule), index_(index),
       paymentAdjustment_(Following),
       inArrears_(false), zeroPayments_(false) {}
@@ -217,7 +223,7 @@ namespace QuantLib {
     IborLeg::operator Leg() const {
 
         Leg leg = FloatingLeg<IborIndex, IborCoupon, CappedFlooredIborCoupon>(
-                         schedule_, notionals_, index_, paymentDayCounter_,
+                         *schedule_, notionals_, index_, paymentDayCounter_,
                          paymentAdjustment_, fixingDays_, gearings_, spreads_,
                          caps_, floors_, inArrears_, zeroPayments_);
 
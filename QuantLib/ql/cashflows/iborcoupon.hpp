@@ -53,6 +53,12 @@ namespace QuantLib {
         const boost::shared_ptr<IborIndex>& iborIndex() const {
             return iborIndex_;
         }
+        //! start of the period spanned by the forecast fixing
+        const Date& fixingValueDate() const { return fixingValueDate_; }
+        //! end of the period spanned by the forecast fixing
+        const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! year fraction between the start and end of the period
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
@@ -75,6 +81,11 @@ namespace QuantLib {
       public:
         IborLeg(const Schedule& schedule,
                 const boost::shared_ptr<IborIndex>& index);
+        /*! The schedule is shared and not copied; this allows
+            legs to use the schedules stored in the ScheduleCache.
+        */
+        IborLeg(const boost::shared_ptr<const Schedule>& schedule,
+                const boost::shared_ptr<IborIndex>& index);
         IborLeg& withNotionals(Real notional);
         IborLeg& withNotionals(const std::vector<Real>& notionals);
         IborLeg& withPaymentDayCounter(const DayCounter&);
@@ -93,7 +104,7 @@ namespace QuantLib {
         IborLeg& withZeroPayments(bool flag = true);
         operator Leg() const;
       private:
-        Schedule schedule_;
+        boost::shared_ptr<const Schedule> schedule_;
         boost::shared_ptr<IborIndex> index_;
         std::vector<Real> notionals_;
         DayCounter paymentDayCounter_;
@@ -42,7 +42,6 @@ namespace QuantLib {
       fixingDays_(fixingDays)
     {
         registerWith(index_);
-        registerWith(Settings::instance().evaluationDate());
     }
 
 
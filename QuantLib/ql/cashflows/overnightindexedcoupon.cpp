@@ -24,6 +24,11 @@
 #include <ql/utilities/vectors.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <algorithm>
+#include <map>
+
 using std::vector;
 using boost::shared_ptr;
 using boost::dynamic_pointer_cast;
@@ -32,11 +37,130 @@ namespace QuantLib {
 
     namespace {
 
+        /* Cumulative products of the compounding factors
+           (1 + r_i \tau_i) over the stored fixings of an overnight
+           index, where \tau_i is the accrual period between the
+           value dates of the i-th and (i+1)-th fixing.  The compounded
+           past fixings in any period are the ratio of two of them.
+
+           One instance is shared by all the coupons on an index.  It
+           is brought up to date when the fixings change; the products
+           are recalculated only from the first modified fixing on, so
+           that appending the fixings of a new day is cheap.
+        */
+        class CompoundingFactors {
+          public:
+            CompoundingFactors() : synchronized_(false), version_(0) {}
+            static shared_ptr<CompoundingFactors> forIndex(
+                                                  const OvernightIndex& i);
+            /* Returns the product of the compounding factors of the
+               n consecutive stored fixings starting at the given date,
+               or a null value if the stored fixings between the given
+               first and last dates are not exactly n.
+            */
+            Real product(const OvernightIndex& index,
+                         const Date& first, const Date& last, Size n) {
+                synchronize(index);
+                Size i = std::lower_bound(dates_.begin(), dates_.end(),
+                                          first) - dates_.begin();
+                // the products are only available up to the last
+                // stored fixing, excluded
+                if (n == 0 || i+n >= dates_.size() ||
+                    dates_[i] != first || dates_[i+n] != last)
+                    return Null<Real>();
+                return products_[i+n] / products_[i];
+            }
+          private:
+            void synchronize(const OvernightIndex& index) {
+                std::string name = index.name();
+                unsigned long version =
+                    IndexManager::instance().version(name);
+                if (synchronized_ && version == version_)
+                    return;
+
+                // keep the fixings up to the first changed one...
+                const TimeSeries<Real>& history =
+                    IndexManager::instance().getHistory(name);
+                TimeSeries<Real>::const_iterator h = history.begin();
+                Size k = 0;
+                while (h != history.end() && ignored(index, h))
+                    ++h;
+                while (k < dates_.size() && h != history.end() &&
+                       h->first == dates_[k] && h->second == fixings_[k]) {
+                    ++k;
+                    ++h;
+                    while (h != history.end() && ignored(index, h))
+                        ++h;
+                }
+                dates_.resize(k);
+                fixings_.resize(k);
+                valueDates_.resize(k);
+                // ...as well as the products not depending on the
+                // following fixings...
+                products_.resize(std::min(products_.size(), k));
+                // ...and append the rest.
+                bool sameDates = (index.fixingDays() == 0);
+                for (; h != history.end(); ++h) {
+                    if (ignored(index, h))
+                        continue;
+                    dates_.push_back(h->first);
+                    fixings_.push_back(h->second);
+                    valueDates_.push_back(sameDates ? h->first :
+                                          index.valueDate(h->first));
+                }
+                const DayCounter& dc = index.dayCounter();
+                if (products_.empty() && !dates_.empty())
+                    products_.push_back(1.0);
+                for (Size j=products_.size(); j<dates_.size(); ++j) {
+                    Time dt = dc.yearFraction(valueDates_[j-1],
+                                              valueDates_[j]);
+                    products_.push_back(products_[j-1] *
+                                        (1.0 + fixings_[j-1]*dt));
+                }
+
+                synchronized_ = true;
+                version_ = version;
+            }
+            // the history might contain null fixings, as well as
+            // fixings at invalid dates if it was set directly
+            static bool ignored(const OvernightIndex& index,
+                                TimeSeries<Real>::const_iterator h) {
+                return h->second == Null<Real>() ||
+                       !index.isValidFixingDate(h->first);
+            }
+            bool synchronized_;
+            unsigned long version_;
+            std::vector<Date> dates_, valueDates_;
+            std::vector<Real> fixings_, products_;
+        };
+
+        // one set of factors per index and per session, as the fixings
+        class CompoundingFactorsManager
+            : public Singleton<CompoundingFactorsManager> {
+            friend class Singleton<CompoundingFactorsManager>;
+          private:
+            CompoundingFactorsManager() {}
+          public:
+            std::map<std::string, shared_ptr<CompoundingFactors> > factors;
+        };
+
+        shared_ptr<CompoundingFactors> CompoundingFactors::forIndex(
+                                                  const OvernightIndex& i) {
+            shared_ptr<CompoundingFactors>& f =
+                CompoundingFactorsManager::instance().factors[i.name()];
+            if (!f)
+                f = shared_ptr<CompoundingFactors>(new CompoundingFactors);
+            return f;
+        }
+
         class OvernightIndexedCouponPricer : public FloatingRateCouponPricer {
           public:
             void initialize(const FloatingRateCoupon& coupon) {
                 coupon_ = dynamic_cast<const OvernightIndexedCoupon*>(&coupon);
                 QL_ENSURE(coupon_, "wrong coupon type");
+                shared_ptr<OvernightIndex> index =
+                    dynamic_pointer_cast<OvernightIndex>(coupon_->index());
+                factors_ = CompoundingFactors::forIndex(*index);
             }
             Rate swapletRate() const {
 
@@ -53,6 +177,23 @@ namespace QuantLib {
 
                 // already fixed part
                 Date today = Settings::instance().evaluationDate();
+                // the fixings before the last past one are compounded
+                // at once when they're all available...
+                Size past = std::lower_bound(fixingDates.begin(),
+                                             fixingDates.end(), today)
+                          - fixingDates.begin();
+                if (past > 1) {
+                    Real product = factors_->product(*index,
+                                                     fixingDates[0],
+                                                     fixingDates[past-1],
+                                                     past-1);
+                    if (product != Null<Real>()) {
+                        compoundFactor = product;
+                        i = past-1;
+                    }
+                }
+                // ...otherwise, or for the remaining ones, they're
+                // retrieved one by one.
                 while (i<n && fixingDates[i]<today) {
                     // rate must have been fixed
                     Rate pastFixing = IndexManager::instance().getHistory(
@@ -108,6 +249,7 @@ namespace QuantLib {
             Rate floorletRate(Rate) const { QL_FAIL("floorletRate not available"); }
           protected:
             const OvernightIndexedCoupon* coupon_;
+            shared_ptr<CompoundingFactors> factors_;
         };
     }
 
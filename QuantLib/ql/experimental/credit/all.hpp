@@ -11,6 +11,7 @@
 #include <ql/experimental/credit/distribution.hpp>
 #include <ql/experimental/credit/factorspreadedhazardratecurve.hpp>
 #include <ql/experimental/credit/issuer.hpp>
+#include <ql/experimental/credit/latticelossmodel.hpp>
 #include <ql/experimental/credit/loss.hpp>
 #include <ql/experimental/credit/lossdistribution.hpp>
 #include <ql/experimental/credit/nthtodefault.hpp>
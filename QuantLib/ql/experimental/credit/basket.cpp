@@ -21,6 +21,7 @@
 #include <ql/experimental/credit/basket.hpp>
 #include <ql/experimental/credit/loss.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <algorithm>
 
 using namespace std;
 
@@ -47,7 +48,8 @@ namespace QuantLib {
           attachmentAmount_(0.0),
           detachmentAmount_(0.0),
           LGDs_(notionals.size(), 0.0),
-          scenarioLoss_(names.size(), Loss(0.0, 0.0)) {
+          scenarioLoss_(names.size(), Loss(0.0, 0.0)),
+          curvesRegistered_(false) {
         QL_REQUIRE(!names_.empty(), "no names given");
         QL_REQUIRE(!notionals_.empty(), "notionals empty");
         QL_REQUIRE (attachmentRatio_ >= 0 &&
@@ -136,6 +138,17 @@ namespace QuantLib {
     }
 
     vector<Real> Basket::probabilities(const Date& d) const {
+        if (!probabilityDates_.empty()) {
+            vector<Date>::const_iterator i =
+                std::lower_bound(probabilityDates_.begin(),
+                                 probabilityDates_.end(), d);
+            if (i != probabilityDates_.end() && *i == d) {
+                calculate();
+                Size row = i - probabilityDates_.begin();
+                return vector<Real>(probabilityGrid_.row_begin(row),
+                                    probabilityGrid_.row_end(row));
+            }
+        }
         vector<Real> prob (names_.size());
         for (Size j = 0; j < names_.size(); j++)
             prob[j] = pool_->get(names_[j]).defaultProbability(
@@ -143,6 +156,34 @@ namespace QuantLib {
         return prob;
     }
 
+    void Basket::addProbabilityDates(const vector<Date>& dates) {
+        if (!curvesRegistered_) {
+            for (Size j = 0; j < names_.size(); j++)
+                registerWith(pool_->get(names_[j]).defaultProbability(
+                                                           defaultKeys_[j]));
+            curvesRegistered_ = true;
+        }
+        vector<Date> grid(probabilityDates_);
+        grid.insert(grid.end(), dates.begin(), dates.end());
+        std::sort(grid.begin(), grid.end());
+        grid.erase(std::unique(grid.begin(), grid.end()), grid.end());
+        if (grid != probabilityDates_) {
+            probabilityDates_.swap(grid);
+            // the grid must be rebuilt; no need to notify observers
+            // since the values on the old dates are unchanged
+            calculated_ = false;
+        }
+    }
+
+    const vector<Date>& Basket::probabilityDates() const {
+        return probabilityDates_;
+    }
+
+    const Matrix& Basket::probabilityGrid() const {
+        calculate();
+        return probabilityGrid_;
+    }
+
     Real Basket::cumulatedLoss(const Date& startDate,
                                const Date& endDate) const {
         Real loss = 0.0;
@@ -309,6 +350,7 @@ namespace QuantLib {
 
     void Basket::performCalculations() const {
         Date today = Settings::instance().evaluationDate();
+        basketLGD_ = 0.0;
         for (Size i = 0; i < notionals_.size(); i++) {
             //we are registered, the quote might have changed.
             QL_REQUIRE(
@@ -321,6 +363,15 @@ namespace QuantLib {
                                                  ));
             basketLGD_ += LGDs_[i];
         }
+
+        probabilityGrid_ = Matrix(probabilityDates_.size(), names_.size());
+        for (Size j = 0; j < names_.size(); j++) {
+            const Handle<DefaultProbabilityTermStructure>& curve =
+                pool_->get(names_[j]).defaultProbability(defaultKeys_[j]);
+            for (Size i = 0; i < probabilityDates_.size(); i++)
+                probabilityGrid_[i][j] =
+                    curve->defaultProbability(probabilityDates_[i]);
+        }
     }
 
 
@@ -32,6 +32,7 @@
 #include <ql/experimental/credit/recoveryratemodel.hpp>
 #include <ql/experimental/credit/pool.hpp>
 #include <ql/experimental/credit/loss.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -95,6 +96,22 @@ namespace QuantLib {
             issuers in the basket.
         */
         std::vector<Real> probabilities(const Date& d) const;
+        /*! Adds the given dates to the grid on which the default
+            probabilities of all issuers are precomputed.  The
+            probabilities on the grid are calculated once and stored
+            in a matrix; they are recalculated, when needed, after a
+            notification from the default-probability curves or from
+            the evaluation date.  probabilities(d) reads from the grid
+            when d is one of its dates.
+        */
+        void addProbabilityDates(const std::vector<Date>& dates);
+        //! Dates of the precomputed probability grid (sorted)
+        const std::vector<Date>& probabilityDates() const;
+        /*! Precomputed default probabilities; the element (i,j) is
+            the probability that the j-th issuer defaults before the
+            i-th grid date.
+        */
+        const Matrix& probabilityGrid() const;
         /*! Actual basket losses between start and end date, taking
             the actual recovery rates of loss events into account.
         */
@@ -184,6 +201,10 @@ namespace QuantLib {
         //! Individual names expected LGDs at the reference date.
         mutable std::vector<Real> LGDs_;
         std::vector<Loss> scenarioLoss_;
+        // precomputed default probabilities
+        std::vector<Date> probabilityDates_;
+        mutable Matrix probabilityGrid_;
+        bool curvesRegistered_;
     };
 
 }
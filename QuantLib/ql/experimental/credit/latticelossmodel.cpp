@@ -0,0 +1,165 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/credit/latticelossmodel.hpp>
+#include <algorithm>
+
+using namespace std;
+
+namespace QuantLib {
+
+    LatticeLossModel::LatticeLossModel(const Handle<OneFactorCopula>& copula,
+                                       Size nBuckets,
+                                       Size quadratureOrder,
+                                       Real lgdAccuracy)
+    : copula_(copula), nBuckets_(nBuckets), lgdAccuracy_(lgdAccuracy) {
+        QL_REQUIRE(nBuckets_ > 0, "at least one bucket required");
+        QL_REQUIRE(lgdAccuracy_ > 0.0,
+                   "non-positive LGD accuracy (" << lgdAccuracy_ << ")");
+        GaussHermiteIntegration quadrature(quadratureOrder);
+        nodes_ = vector<Real>(quadrature.x().begin(), quadrature.x().end());
+        weights_ = vector<Real>(quadrature.weights().begin(),
+                                quadrature.weights().end());
+        registerWith(copula_);
+    }
+
+    void LatticeLossModel::update() {
+        cache_.clear();
+        notifyObservers();
+    }
+
+    Real LatticeLossModel::lossUnit(const Basket& basket) const {
+        const vector<Real>& lgds = basket.LGDs();
+        Real minimum = QL_MAX_REAL;
+        for (Size i = 0; i < lgds.size(); i++)
+            if (lgds[i] > 0.0)
+                minimum = std::min(minimum, lgds[i]);
+        // all names have null LGD; any unit will do
+        if (minimum == QL_MAX_REAL)
+            return 1.0;
+        if (nBuckets_ != Null<Size>())
+            return minimum / nBuckets_;
+
+        // Since the smallest LGD is at least one unit, no LGD is
+        // rounded by more than 1/(2k) in relative terms when the unit
+        // is divided into k buckets; the loop stops there at most.
+        Size maxBuckets =
+            static_cast<Size>(std::ceil(0.5/lgdAccuracy_));
+        for (Size k = 1; k < maxBuckets; k++) {
+            Real unit = minimum / k;
+            bool accurate = true;
+            for (Size i = 0; i < lgds.size() && accurate; i++) {
+                Real rounded = std::floor(lgds[i]/unit + 0.5) * unit;
+                accurate =
+                    std::fabs(rounded - lgds[i]) <= lgdAccuracy_ * lgds[i];
+            }
+            if (accurate)
+                return unit;
+        }
+        return minimum / maxBuckets;
+    }
+
+    const LatticeLossModel::Entry&
+    LatticeLossModel::entry(const Basket& basket, const Date& date) const {
+        vector<Probability> probabilities = basket.probabilities(date);
+        const vector<Real>& lgds = basket.LGDs();
+
+        map<Date, Entry>::iterator i = cache_.find(date);
+        if (i != cache_.end()
+            && i->second.probabilities == probabilities
+            && i->second.lgds == lgds)
+            return i->second;
+
+        Entry& e = cache_[date];
+        e.probabilities.swap(probabilities);
+        e.lgds = lgds;
+        e.lossUnit = lossUnit(basket);
+        calculate(e);
+        return e;
+    }
+
+    void LatticeLossModel::calculate(Entry& e) const {
+        Size n = e.lgds.size();
+
+        // integer loss weights on the lattice
+        vector<Size> w(n);
+        Size total = 0;
+        for (Size i = 0; i < n; i++) {
+            w[i] = static_cast<Size>(std::floor(e.lgds[i]/e.lossUnit + 0.5));
+            total += w[i];
+        }
+
+        // default thresholds, computed once for all quadrature nodes
+        Real c = copula_->correlation();
+        Real sqrtC = std::sqrt(c), sqrtOneMinusC = std::sqrt(1.0 - c);
+        vector<Real> thresholds = copula_->thresholds(e.probabilities);
+        vector<bool> canDefault(n, false);
+        for (Size i = 0; i < n; i++)
+            canDefault[i] = (thresholds[i] != Null<Real>() && w[i] > 0);
+
+        e.distribution.assign(total+1, 0.0);
+        vector<Probability> conditional(total+1);
+        for (Size j = 0; j < nodes_.size(); j++) {
+            Real m = nodes_[j];
+            Real weight = weights_[j] * copula_->density(m);
+
+            std::fill(conditional.begin(), conditional.end(), 0.0);
+            conditional[0] = 1.0;
+            Size top = 0;
+            for (Size i = 0; i < n; i++) {
+                if (!canDefault[i])
+                    continue;
+                Probability p = copula_->cumulativeZ(
+                                 (thresholds[i] - sqrtC * m) / sqrtOneMinusC);
+                Probability q = 1.0 - p;
+                Size wi = w[i];
+                // in place, from the top so that the lower losses
+                // are still unchanged when they're read
+                for (Size k = top + wi; k >= wi; k--)
+                    conditional[k] = conditional[k] * q
+                                   + conditional[k-wi] * p;
+                for (Size k = 0; k < wi && k <= top; k++)
+                    conditional[k] *= q;
+                top += wi;
+            }
+
+            for (Size k = 0; k <= top; k++)
+                e.distribution[k] += weight * conditional[k];
+        }
+    }
+
+    const vector<Probability>& LatticeLossModel::lossProbabilities(
+                                                  const Basket& basket,
+                                                  const Date& date) const {
+        return entry(basket, date).distribution;
+    }
+
+    Real LatticeLossModel::expectedTrancheLoss(const Basket& basket,
+                                               const Date& date) const {
+        const Entry& e = entry(basket, date);
+        Real a = basket.attachmentAmount();
+        Real d = basket.detachmentAmount();
+        Real expected = 0.0;
+        for (Size k = 0; k < e.distribution.size(); k++) {
+            Real loss = k * e.lossUnit;
+            expected += std::min(std::max(loss - a, 0.0), d - a)
+                      * e.distribution[k];
+        }
+        return expected;
+    }
+
+}
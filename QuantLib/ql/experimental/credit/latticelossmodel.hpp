@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file latticelossmodel.hpp
+    \brief Pool loss distribution on a common loss lattice
+*/
+
+#ifndef quantlib_lattice_loss_model_hpp
+#define quantlib_lattice_loss_model_hpp
+
+#include <ql/experimental/credit/syntheticcdoengines.hpp>
+#include <ql/experimental/credit/onefactorcopula.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! Pool loss distribution on a common loss lattice
+    /*! The losses given default of the names in the pool are rounded
+        to integer multiples of a loss unit, taken as the smallest
+        non-null LGD divided by a number of buckets.  If the number
+        of buckets is not given, the smallest one is chosen for which
+        each LGD is rounded by no more than the given relative
+        accuracy; for a homogeneous pool, this is a single bucket.
+        The lattice grows with the number of buckets.  For each
+        node of a Gauss-Hermite quadrature over the market factor,
+        the conditional distribution of the pool loss is built on the
+        lattice with the recursion of Andersen, Sidenius and Basu
+        ("All your hedges in one basket", Risk, November 2003) working
+        in place on a contiguous array; the unconditional distribution
+        is the weighted sum over the nodes.
+
+        The distribution does not depend on the tranche; it is cached
+        for each date, so that all the tranches written on the same
+        pool (and sharing the same model instance) reuse it.  A cached
+        distribution is reused only if the probabilities and LGDs of
+        the basket match the ones it was built from; therefore,
+        changes in the default curves or recovery rates are picked up
+        without the need for notifications.
+
+        \ingroup credit
+    */
+    class LatticeLossModel : public Observer, public Observable {
+      public:
+        LatticeLossModel(const Handle<OneFactorCopula>& copula,
+                         Size nBuckets = Null<Size>(),
+                         Size quadratureOrder = 20,
+                         Real lgdAccuracy = 0.01);
+        //! expected loss of the basket tranche at the given date
+        Real expectedTrancheLoss(const Basket& basket,
+                                 const Date& date) const;
+        //! probabilities of the pool losses \f$ k \cdot u \f$
+        const std::vector<Probability>& lossProbabilities(
+                                                  const Basket& basket,
+                                                  const Date& date) const;
+        //! loss unit \f$ u \f$ of the lattice used for the basket
+        Real lossUnit(const Basket& basket) const;
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+      private:
+        struct Entry {
+            std::vector<Probability> probabilities;
+            std::vector<Real> lgds;
+            Real lossUnit;
+            std::vector<Probability> distribution;
+        };
+        const Entry& entry(const Basket& basket, const Date& date) const;
+        void calculate(Entry& e) const;
+
+        Handle<OneFactorCopula> copula_;
+        Size nBuckets_;
+        Real lgdAccuracy_;
+        std::vector<Real> nodes_, weights_;
+        mutable std::map<Date, Entry> cache_;
+    };
+
+
+    //! CDO engine using a (possibly shared) lattice loss model
+    template <class CDOEngine>
+    class LatticeLossCDOEngine : public CDOEngine {
+      public:
+        LatticeLossCDOEngine(const boost::shared_ptr<LatticeLossModel>& model)
+        : model_(model) {
+            this->registerWith(model_);
+        }
+      private:
+        Real expectedTrancheLoss(const Date& d) const {
+            return model_->expectedTrancheLoss(*this->remainingBasket_, d);
+        }
+        boost::shared_ptr<LatticeLossModel> model_;
+    };
+
+    typedef LatticeLossCDOEngine<MidPointCDOEngine> LatticeMidPointCDOEngine;
+    typedef LatticeLossCDOEngine<IntegralCDOEngine> LatticeIntegralCDOEngine;
+
+}
+
+#endif
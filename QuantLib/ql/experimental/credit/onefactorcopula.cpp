@@ -53,6 +53,57 @@ namespace QuantLib {
         return p;
     }
 
+    //-------------------------------------------------------------------------
+    vector<Real> OneFactorCopula::thresholds(const vector<Real>& prob) const {
+    //-------------------------------------------------------------------------
+        calculate ();
+        map<vector<Real>, CachedThresholds>::iterator i =
+            thresholds_.find(prob);
+        if (i != thresholds_.end()) {
+            thresholdUsage_.splice(thresholdUsage_.begin(), thresholdUsage_,
+                                   i->second.use);
+            return i->second.thresholds;
+        }
+
+        vector<Real> y (prob.size(), Null<Real>());
+        for (Size j = 0; j < y.size(); j++) {
+            // same cutoff as in conditionalProbability
+            if (prob[j] >= 1e-10)
+                y[j] = inverseCumulativeY (prob[j]);
+        }
+
+        if (thresholds_.size() >= maxCachedThresholds) {
+            thresholds_.erase(thresholdUsage_.back());
+            thresholdUsage_.pop_back();
+        }
+        CachedThresholds& entry = thresholds_[prob];
+        entry.thresholds = y;
+        entry.use = thresholdUsage_.insert(thresholdUsage_.begin(), prob);
+        return y;
+    }
+
+    //-------------------------------------------------------------------------
+    void OneFactorCopula::conditionalProbabilityFromThresholds(
+                                                    const vector<Real>& y,
+                                                    Real m,
+                                                    vector<Real>& p) const {
+    //-------------------------------------------------------------------------
+        calculate ();
+        Real c = correlation_->value();
+        Real sqrtC = sqrt(c), sqrtOneMinusC = sqrt (1. - c);
+        p.resize(y.size());
+        for (Size i = 0; i < y.size(); i++) {
+            if (y[i] == Null<Real>()) {
+                p[i] = 0.0;
+            } else {
+                p[i] = cumulativeZ ((y[i] - sqrtC * m) / sqrtOneMinusC);
+                QL_REQUIRE (p[i] >= 0 && p[i] <= 1,
+                            "conditional probability " << p[i]
+                            << "out of range");
+            }
+        }
+    }
+
     //-------------------------------------------------------------------------
     Real OneFactorCopula::cumulativeY (Real y) const {
     //-------------------------------------------------------------------------
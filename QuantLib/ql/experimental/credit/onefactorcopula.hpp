@@ -27,6 +27,8 @@
 #include <ql/experimental/credit/distribution.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
@@ -156,6 +158,32 @@ namespace QuantLib {
         std::vector<Real> conditionalProbability(const std::vector<Real>& prob,
                                                  Real m) const;
 
+        //! Default thresholds
+        /*! Returns \f$ y_i = F_Y^{-1}(p_i) \f$ for each probability,
+            or Null<Real>() for probabilities below \f$ 10^{-10} \f$
+            (whose conditional probabilities are taken as null).
+            The thresholds are cached for each vector of
+            probabilities (usually, the default probabilities of a
+            basket at one of the dates of its grid) until the copula
+            is notified of a change, so that the (possibly costly)
+            inversion is done once regardless of the number of
+            integration steps, tranches or engines using it.  As for
+            other lazy objects, this makes it unsafe to use the same
+            copula from different threads.
+        */
+        std::vector<Real> thresholds(const std::vector<Real>& prob) const;
+
+        //! Vector of conditional probabilities given the thresholds
+        /*! \f[
+            \hat p_i(m) = F_Z \left( \frac{y_i-a\,m}{\sqrt{1-a^2}} \right)
+            \f]
+            with the \f$ y_i \f$ returned by thresholds().
+        */
+        void conditionalProbabilityFromThresholds(
+                                          const std::vector<Real>& thresholds,
+                                          Real m,
+                                          std::vector<Real>& result) const;
+
         /*! Integral over the density \f$ \rho(m) \f$ of M and the conditional
             probability related to p:
 
@@ -169,10 +197,12 @@ namespace QuantLib {
                        << " out of range [0,1]");
             calculate();
 
+            std::vector<Real> y = thresholds(std::vector<Real>(1, p));
+            std::vector<Real> pp(1);
             Real avg = 0;
             for (Size k = 0; k < steps(); k++) {
-                Real pp = conditionalProbability(p, m(k));
-                avg += pp * densitydm(k);
+                conditionalProbabilityFromThresholds(y, m(k), pp);
+                avg += pp[0] * densitydm(k);
             }
             return avg;
         }
@@ -192,10 +222,11 @@ namespace QuantLib {
         Real integral(const F& f, std::vector<Real>& probabilities) const {
             calculate();
 
+            std::vector<Real> y = thresholds(probabilities);
+            std::vector<Real> conditional(y.size());
             Real avg = 0.0;
             for (Size i = 0; i < steps_; i++) {
-                std::vector<Real> conditional
-                    = conditionalProbability(probabilities, m(i));
+                conditionalProbabilityFromThresholds(y, m(i), conditional);
                 Real prob = f(conditional);
                 avg += prob * densitydm(i);
             }
@@ -219,9 +250,10 @@ namespace QuantLib {
             calculate();
 
             Distribution dist(f.buckets(), 0.0, f.maximum());
+            std::vector<Real> y = thresholds(probabilities);
+            std::vector<Real> conditional(y.size());
             for (Size i = 0; i < steps(); i++) {
-                std::vector<Real> conditional
-                    = conditionalProbability(probabilities, m(i));
+                conditionalProbabilityFromThresholds(y, m(i), conditional);
                 Distribution d = f(nominals, conditional);
                 for (Size j = 0; j < dist.size(); j++)
                     dist.addDensity(j, d.density(j) * densitydm(i));
@@ -236,6 +268,11 @@ namespace QuantLib {
         */
         int checkMoments(Real tolerance) const;
 
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+
       protected:
         Handle<Quote> correlation_;
         mutable Real max_;
@@ -246,6 +283,19 @@ namespace QuantLib {
         mutable std::vector<Real> y_;
         mutable std::vector<Real> cumulativeY_;
 
+        /* cached thresholds for the last probability vectors,
+           cleared on notification; the least recently used ones
+           are discarded when maxCachedThresholds are stored.
+        */
+        static const Size maxCachedThresholds = 1000;
+        typedef std::list<std::vector<Real> > threshold_usage;
+        struct CachedThresholds {
+            std::vector<Real> thresholds;
+            threshold_usage::iterator use;
+        };
+        mutable std::map<std::vector<Real>, CachedThresholds> thresholds_;
+        mutable threshold_usage thresholdUsage_;
+
         //private:
         // utilities for simple Euler integrations over the density of M
         Size steps() const;
@@ -262,6 +312,12 @@ namespace QuantLib {
         return correlation_->value();
     }
 
+    inline void OneFactorCopula::update() {
+        thresholds_.clear();
+        thresholdUsage_.clear();
+        LazyObject::update();
+    }
+
     inline Size OneFactorCopula::steps() const {
         return steps_;
     }
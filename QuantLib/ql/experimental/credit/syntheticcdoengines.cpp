@@ -26,6 +26,42 @@ using namespace std;
 
 namespace QuantLib {
 
+    //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    vector<pair<Date, Date> > IntegralCDOEngine::steps() const {
+        Date today = Settings::instance().evaluationDate();
+        const vector<Date>& dates = arguments_.schedule.dates();
+        vector<pair<Date, Date> > result;
+        for (Size i = 1; i < dates.size(); i++) {
+            Date d2 = dates[i];
+            if (d2 < today)
+                continue;
+
+            Date d1 = dates[i-1];
+
+            Date d, d0 = d1;
+            do {
+                d = NullCalendar().advance (d0 > today ? d0 : today,
+                                            stepSize_);
+                if (d > d2) d = d2;
+                result.push_back(make_pair(d0, d));
+                d0 = d;
+            }
+            while (d < d2);
+        }
+        return result;
+    }
+
+    //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    vector<Date> IntegralCDOEngine::lossDates() const {
+        // the ends of the steps are added to the schedule dates, so
+        // that the probabilities are precomputed on each of them
+        vector<Date> dates = arguments_.schedule.dates();
+        vector<pair<Date, Date> > s = steps();
+        for (Size i = 0; i < s.size(); i++)
+            dates.push_back(s[i].second);
+        return dates;
+    }
+
     //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     void IntegralCDOEngine::calculate() const {
         Date today = Settings::instance().evaluationDate();
@@ -46,36 +82,24 @@ namespace QuantLib {
         if (arguments_.schedule.dates().front() > today)
             e1 = expectedTrancheLoss (arguments_.schedule.dates()[0]);
 
-        for (Size i = 1; i < arguments_.schedule.size(); i++) {
-            Date d2 = arguments_.schedule.dates()[i];
-            if (d2 < today)
-                continue;
+        vector<pair<Date, Date> > s = steps();
+        for (Size i = 0; i < s.size(); i++) {
+            Date d0 = s[i].first, d = s[i].second;
 
-            Date d1 = arguments_.schedule.dates()[i-1];
+            Real e2 = expectedTrancheLoss (d);
 
-            Date d, d0 = d1;
-            do {
-                d = NullCalendar().advance (d0 > today ? d0 : today,
-                                            stepSize_);
-                if (d > d2) d = d2;
-
-                Real e2 = expectedTrancheLoss (d);
-
-                results_.premiumValue
-                    += (results_.remainingNotional - e2)
-                    * arguments_.runningRate
-                    * arguments_.dayCounter.yearFraction (d0, d)
-                    * arguments_.yieldTS->discount (d);
+            results_.premiumValue
+                += (results_.remainingNotional - e2)
+                * arguments_.runningRate
+                * arguments_.dayCounter.yearFraction (d0, d)
+                * arguments_.yieldTS->discount (d);
 
-                if (e2 < e1) results_.error ++;
+            if (e2 < e1) results_.error ++;
 
-                results_.protectionValue
-                    += (e2 - e1) * arguments_.yieldTS->discount (d);
+            results_.protectionValue
+                += (e2 - e1) * arguments_.yieldTS->discount (d);
 
-                d0 = d;
-                e1 = e2;
-            }
-            while (d < d2);
+            e1 = e2;
         }
 
         if (arguments_.schedule.dates().front() >= today)
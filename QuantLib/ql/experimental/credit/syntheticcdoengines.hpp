@@ -41,6 +41,12 @@ namespace QuantLib {
                                                       SyntheticCDO::results> {
     protected:
         virtual Real expectedTrancheLoss(const Date&) const = 0;
+        /*! Dates on which the engine asks for the expected tranche
+            loss; the default probabilities are precomputed on them.
+        */
+        virtual std::vector<Date> lossDates() const {
+            return arguments_.schedule.dates();
+        }
         virtual void initialize() const {
             Date today = Settings::instance().evaluationDate();
             Date start = this->arguments_.schedule.startDate();
@@ -54,16 +60,36 @@ namespace QuantLib {
             Real a = basket->remainingAttachmentRatio(start, today);
             Real d = basket->remainingDetachmentRatio(start, today);
             const boost::shared_ptr<Pool> pool = basket->pool();
-            remainingBasket_ =
-                boost::shared_ptr<Basket>(new Basket(names, notionals, pool,
+            // the remaining basket, and the default probabilities
+            // precomputed on its grid, are kept as long as the
+            // evaluation date and the remaining names don't change;
+            // the basket recalculates them if the curves change.
+            if (!remainingBasket_ || remainingBasketDate_ != today
+                || remainingBasket_->pool() != pool
+                || remainingBasket_->names() != names
+                || remainingBasket_->notionals() != notionals
+                || remainingBasket_->attachmentRatio() != a
+                || remainingBasket_->detachmentRatio() != d) {
+                remainingBasket_ =
+                    boost::shared_ptr<Basket>(new Basket(names, notionals, pool,
                                                     basket->remainingDefaultKeys(start, today),
                                                     basket->remainingRecModels(start, today),
                                                      a, d));
+                remainingBasketDate_ = today;
+            }
 
             this->results_.xMin = remainingBasket_->attachmentAmount();
             this->results_.xMax = remainingBasket_->detachmentAmount();
             this->results_.remainingNotional = results_.xMax - results_.xMin;
 
+            // default probabilities are computed once on the future
+            // loss dates; the curves can't return them for past ones
+            std::vector<Date> grid = lossDates(), futureDates;
+            for (Size i = 0; i < grid.size(); i++)
+                if (grid[i] > today)
+                    futureDates.push_back(grid[i]);
+            remainingBasket_->addProbabilityDates(futureDates);
+
             const std::vector<Date>& dates = arguments_.schedule.dates();
             for (Size i = 0; i < dates.size(); i++) {
                 if (dates[i] <= today)
@@ -75,6 +101,7 @@ namespace QuantLib {
             }
         }
         mutable boost::shared_ptr<Basket> remainingBasket_;
+        mutable Date remainingBasketDate_;
     };
 
     //--------------------------------------------------------------------------
@@ -95,6 +122,9 @@ namespace QuantLib {
         IntegralCDOEngine(Period stepSize = 3*Months) : stepSize_(stepSize) {}
     private:
         virtual Real expectedTrancheLoss(const Date&) const = 0;
+        std::vector<Date> lossDates() const;
+        // start and end of the integration steps, in order
+        std::vector<std::pair<Date, Date> > steps() const;
     protected:
         Period stepSize_;
     };
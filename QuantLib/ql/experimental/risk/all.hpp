@@ -1,5 +1,7 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/experimental/risk/curvesensitivities.hpp>
+#include <ql/experimental/risk/scenarioengine.hpp>
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 
@@ -0,0 +1,111 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/curvesensitivities.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/settings.hpp>
+
+using boost::shared_ptr;
+using boost::dynamic_pointer_cast;
+
+namespace QuantLib {
+
+    namespace {
+
+        // same logic as IborCoupon::indexFixing
+        bool isForecast(const IborCoupon& coupon) {
+            Date today = Settings::instance().evaluationDate();
+            Date fixingDate = coupon.fixingDate();
+            if (fixingDate > today)
+                return true;
+            if (fixingDate < today ||
+                Settings::instance().enforcesTodaysHistoricFixings())
+                return false;
+            try {
+                return coupon.index()->pastFixing(fixingDate) == Null<Real>();
+            } catch (Error&) {
+                return true;
+            }
+        }
+
+    }
+
+    void addDiscountSensitivities(
+                         std::map<Date, Real>& sensitivities,
+                         const Leg& leg,
+                         Real quantity,
+                         const shared_ptr<YieldTermStructure>& curve,
+                         boost::optional<bool> includeSettlementDateFlows) {
+        addDiscountSensitivities(sensitivities, sensitivities, leg, quantity,
+                                 curve, curve, includeSettlementDateFlows);
+    }
+
+    void addDiscountSensitivities(
+                 std::map<Date, Real>& discountSensitivities,
+                 std::map<Date, Real>& forwardingSensitivities,
+                 const Leg& leg,
+                 Real quantity,
+                 const shared_ptr<YieldTermStructure>& discountCurve,
+                 const shared_ptr<YieldTermStructure>& forwardingCurve,
+                 boost::optional<bool> includeSettlementDateFlows) {
+        QL_REQUIRE(discountCurve, "null discount term structure");
+        QL_REQUIRE(forwardingCurve, "null forwarding term structure");
+
+        Date refDate = discountCurve->referenceDate();
+        bool includeRefDateFlows =
+            includeSettlementDateFlows ?
+            *includeSettlementDateFlows :
+            Settings::instance().includeReferenceDateEvents();
+
+        for (Size i=0; i<leg.size(); ++i) {
+            const shared_ptr<CashFlow>& cf = leg[i];
+            if (cf->hasOccurred(refDate, includeRefDateFlows))
+                continue;
+
+            shared_ptr<IborCoupon> coupon =
+                dynamic_pointer_cast<IborCoupon>(cf);
+            if (coupon && !coupon->isInArrears()
+                && dynamic_pointer_cast<BlackIborCouponPricer>(
+                                                          coupon->pricer())
+                && !coupon->iborIndex()->forwardingTermStructure().empty()
+                && coupon->iborIndex()->forwardingTermStructure()
+                                        .currentLink() == forwardingCurve
+                && isForecast(*coupon)) {
+                // the amount is N a (g (F(d1)/F(d2) - 1)/t + s),
+                // paid at the payment date d and discounted by P(d)
+                Date d1 = coupon->fixingValueDate();
+                Date d2 = coupon->fixingEndDate();
+                DiscountFactor p = discountCurve->discount(coupon->date());
+                DiscountFactor p1 = forwardingCurve->discount(d1);
+                DiscountFactor p2 = forwardingCurve->discount(d2);
+                Time t = coupon->spanningTime();
+                Real k = quantity * coupon->nominal()
+                       * coupon->accrualPeriod();
+                Real g = coupon->gearing();
+
+                discountSensitivities[coupon->date()] +=
+                    k * (g*(p1/p2 - 1.0)/t + coupon->spread());
+                forwardingSensitivities[d1] += k * g * p / (t*p2);
+                forwardingSensitivities[d2] -= k * g * p * p1 / (t*p2*p2);
+            } else {
+                discountSensitivities[cf->date()] += quantity * cf->amount();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file curvesensitivities.hpp
+    \brief analytic sensitivities of legs to the quotes of a curve
+*/
+
+#ifndef quantlib_curve_sensitivities_hpp
+#define quantlib_curve_sensitivities_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/math/matrix.hpp>
+#include <boost/optional.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! adds the sensitivities of a leg to the discount factors of a curve
+    /*! The derivatives \f$ \partial V / \partial P(d) \f$ of the
+        value \f$ V \f$ of the given quantity of the leg, discounted
+        on the curve to its reference date, with respect to the
+        discount factors \f$ P(d) \f$ of the same curve are added to
+        the passed map; legs of a whole portfolio can be accumulated
+        in the same map.
+
+        Each cash flow contributes through its payment date.  Ibor
+        coupons with the default Black pricer, not in arrears and
+        whose fixing is forecast on the same curve also contribute
+        through the start and end dates of their forecast period;
+        any other amount is taken as independent of the curve.
+    */
+    void addDiscountSensitivities(
+                    std::map<Date, Real>& sensitivities,
+                    const Leg& leg,
+                    Real quantity,
+                    const boost::shared_ptr<YieldTermStructure>& curve,
+                    boost::optional<bool> includeSettlementDateFlows =
+                                                                boost::none);
+
+    //! adds the sensitivities of a leg to a discount and a forwarding curve
+    /*! As above, but for a leg discounted on one curve and whose
+        Ibor coupons are forecast on another.  The derivatives with
+        respect to the discount factors of the discount curve are
+        added to the first map, and those with respect to the discount
+        factors of the forwarding curve to the second; the two maps
+        can then be passed to bucketSensitivities() together with the
+        corresponding curve.  Ibor coupons forecast on any other curve
+        are taken as independent of both.
+    */
+    void addDiscountSensitivities(
+                    std::map<Date, Real>& discountSensitivities,
+                    std::map<Date, Real>& forwardingSensitivities,
+                    const Leg& leg,
+                    Real quantity,
+                    const boost::shared_ptr<YieldTermStructure>& discountCurve,
+                    const boost::shared_ptr<YieldTermStructure>&
+                                                             forwardingCurve,
+                    boost::optional<bool> includeSettlementDateFlows =
+                                                                boost::none);
+
+    //! bucketed sensitivities to the quotes of a piecewise curve
+    /*! Returns the derivatives \f$ \partial V / \partial q_j \f$ of
+        a value with respect to the quotes of the instruments of the
+        curve, in the order returned by its instruments() method,
+        given the sensitivities of the value to the discount factors
+        of the curve as calculated by addDiscountSensitivities().
+
+        Unlike bucketAnalysis(), this requires neither bootstrapping
+        the curve again nor repricing the instruments for each quote.
+    */
+    template <class Curve>
+    std::vector<Real> bucketSensitivities(
+                              const std::map<Date, Real>& sensitivities,
+                              const Curve& curve) {
+        std::vector<Date> dates;
+        dates.reserve(sensitivities.size());
+        std::map<Date, Real>::const_iterator i;
+        for (i=sensitivities.begin(); i!=sensitivities.end(); ++i)
+            dates.push_back(i->first);
+
+        Matrix derivatives = curve.discountSensitivities(dates);
+
+        std::vector<Real> result(derivatives.columns(), 0.0);
+        Size k = 0;
+        for (i=sensitivities.begin(); i!=sensitivities.end(); ++i, ++k) {
+            for (Size j=0; j<result.size(); ++j)
+                result[j] += i->second * derivatives[k][j];
+        }
+        return result;
+    }
+
+}
+
+#endif
@@ -0,0 +1,203 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenarioengine.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/settings.hpp>
+#include <algorithm>
+#include <string>
+
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#include <boost/thread/thread.hpp>
+#include <boost/ref.hpp>
+#endif
+
+namespace QuantLib {
+
+    namespace {
+
+        // settings and fixings of the calling session, to be
+        // replicated in the worker threads
+        class SessionData {
+          public:
+            SessionData()
+            : evaluationDate_(Settings::instance().evaluationDate().value()),
+              includeReferenceDateEvents_(
+                         Settings::instance().includeReferenceDateEvents()),
+              includeTodaysCashFlows_(
+                         Settings::instance().includeTodaysCashFlows()),
+              enforcesTodaysHistoricFixings_(
+                         Settings::instance().enforcesTodaysHistoricFixings()) {
+                IndexManager& manager = IndexManager::instance();
+                std::vector<std::string> names = manager.histories();
+                for (Size i=0; i<names.size(); ++i)
+                    histories_.push_back(
+                        std::make_pair(names[i],
+                                       manager.getHistory(names[i])));
+            }
+            void restore() const {
+                Settings& settings = Settings::instance();
+                settings.evaluationDate() = evaluationDate_;
+                settings.includeReferenceDateEvents() =
+                    includeReferenceDateEvents_;
+                settings.includeTodaysCashFlows() = includeTodaysCashFlows_;
+                settings.enforcesTodaysHistoricFixings() =
+                    enforcesTodaysHistoricFixings_;
+                IndexManager& manager = IndexManager::instance();
+                for (Size i=0; i<histories_.size(); ++i)
+                    manager.setHistory(histories_[i].first,
+                                       histories_[i].second);
+            }
+          private:
+            Date evaluationDate_;
+            bool includeReferenceDateEvents_;
+            boost::optional<bool> includeTodaysCashFlows_;
+            bool enforcesTodaysHistoricFixings_;
+            std::vector<std::pair<std::string,TimeSeries<Real> > > histories_;
+        };
+
+        // evaluates the scenarios in [begin,end) on its own copy
+        // of the portfolio
+        class Worker {
+          public:
+            Worker(const ScenarioEngine::Builder& builder,
+                   const Matrix& shifts, Size begin, Size end,
+                   const SessionData* session)
+            : builder_(builder), shifts_(shifts), begin_(begin), end_(end),
+              session_(session) {}
+            void operator()() {
+                try {
+                    if (session_)
+                        session_->restore();
+                    calculate();
+                } catch (std::exception& e) {
+                    error_ = e.what();
+                    if (error_.empty())
+                        error_ = "unknown error";
+                } catch (...) {
+                    error_ = "unknown error";
+                }
+            }
+            const Matrix& results() const { return results_; }
+            const std::string& error() const { return error_; }
+          private:
+            void calculate() {
+                // the copy must be destroyed before the thread exits
+                // and its session with it
+                ScenarioEngine::Portfolio portfolio = builder_.build();
+                const std::vector<boost::shared_ptr<SimpleQuote> >& quotes =
+                    portfolio.quotes;
+                const std::vector<boost::shared_ptr<Instrument> >&
+                    instruments = portfolio.instruments;
+                QL_REQUIRE(quotes.size() == shifts_.columns(),
+                           "mismatch between number of quotes ("
+                           << quotes.size() << ") and of shifts ("
+                           << shifts_.columns() << ")");
+
+                Size n = instruments.size();
+                std::vector<Real> baseQuotes(quotes.size());
+                for (Size j=0; j<quotes.size(); ++j) {
+                    QL_REQUIRE(quotes[j], "null quote");
+                    baseQuotes[j] = quotes[j]->value();
+                }
+                std::vector<Real> baseNPVs(n);
+                for (Size k=0; k<n; ++k) {
+                    QL_REQUIRE(instruments[k], "null instrument");
+                    baseNPVs[k] = instruments[k]->NPV();
+                }
+
+                results_ = Matrix(end_-begin_, n);
+                for (Size i=begin_; i<end_; ++i) {
+                    // quotes don't notify if their value doesn't
+                    // change; therefore, only the instruments depending
+                    // on the quotes shifted since the last scenario
+                    // are recalculated.
+                    for (Size j=0; j<quotes.size(); ++j)
+                        quotes[j]->setValue(baseQuotes[j] + shifts_[i][j]);
+                    for (Size k=0; k<n; ++k)
+                        results_[i-begin_][k] =
+                            instruments[k]->NPV() - baseNPVs[k];
+                }
+            }
+
+            const ScenarioEngine::Builder& builder_;
+            const Matrix& shifts_;
+            Size begin_, end_;
+            const SessionData* session_;
+            Matrix results_;
+            std::string error_;
+        };
+
+    }
+
+    ScenarioEngine::ScenarioEngine(const boost::shared_ptr<Builder>& builder,
+                                   Size workers)
+    : builder_(builder), workers_(workers) {
+        QL_REQUIRE(builder_, "null portfolio builder");
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
+        #if !defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        QL_REQUIRE(workers_ == 1,
+                   workers_ << " workers requested; "
+                   "thread-local sessions must be enabled "
+                   "to use more than one");
+        #endif
+    }
+
+    Disposable<Matrix> ScenarioEngine::results(const Matrix& shifts) const {
+        Size scenarios = shifts.rows();
+
+        std::vector<boost::shared_ptr<Worker> > workers;
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        SessionData session;
+        Size n = std::max<Size>(std::min(workers_, scenarios), 1);
+        for (Size w=0; w<n; ++w) {
+            // contiguous blocks of almost equal size
+            Size begin = (w*scenarios)/n, end = ((w+1)*scenarios)/n;
+            workers.push_back(boost::shared_ptr<Worker>(
+                        new Worker(*builder_, shifts, begin, end, &session)));
+        }
+        boost::thread_group threads;
+        for (Size w=0; w<n; ++w)
+            threads.create_thread(boost::ref(*workers[w]));
+        threads.join_all();
+        #else
+        workers.push_back(boost::shared_ptr<Worker>(
+                           new Worker(*builder_, shifts, 0, scenarios, 0)));
+        (*workers.front())();
+        #endif
+
+        for (Size w=0; w<workers.size(); ++w)
+            QL_REQUIRE(workers[w]->error().empty(),
+                       "scenario engine: " << workers[w]->error());
+
+        Size instruments = workers.front()->results().columns();
+        Matrix results(scenarios, instruments);
+        Size row = 0;
+        for (Size w=0; w<workers.size(); ++w) {
+            const Matrix& block = workers[w]->results();
+            QL_REQUIRE(block.columns() == instruments,
+                       "mismatch between number of instruments ("
+                       << block.columns() << ", " << instruments
+                       << ") in different portfolio copies");
+            std::copy(block.begin(), block.end(),
+                      results.begin() + row*instruments);
+            row += block.rows();
+        }
+        return results;
+    }
+
+}
@@ -0,0 +1,96 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenarioengine.hpp
+    \brief scenario analysis over independent copies of a portfolio
+*/
+
+#ifndef quantlib_scenario_engine_hpp
+#define quantlib_scenario_engine_hpp
+
+#include <ql/quotes/simplequote.hpp>
+#include <ql/instrument.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Scenario analysis over independent copies of a portfolio
+    /*! The sensitivity-analysis functions reprice the instruments
+        after modifying the quotes of a single market in place;
+        therefore, the scenarios can't be evaluated concurrently.
+        This class asks instead a user-provided builder for a
+        separate copy of the market quotes and of the instruments
+        depending on them for each worker, and has each worker
+        evaluate a contiguous block of scenarios on its own copy.
+
+        A scenario is a row of absolute shifts to the values of the
+        quotes; a matrix of shifts can hold a few bumps as well as a
+        full set of historical moves.  The result is the matrix of
+        the changes in the NPVs of the instruments, with a row for
+        each scenario and a column for each instrument.
+
+        Workers run in separate threads, which requires thread-local
+        sessions to be enabled (see the QL_ENABLE_THREAD_LOCAL_SESSIONS
+        flag in userconfig.hpp) so that each thread has its own
+        settings and fixings; the evaluation date, the other settings
+        and the index fixings of the calling thread are copied into
+        each worker thread before its copy is built.  Otherwise, a
+        single worker is allowed, and all the scenarios are evaluated
+        in the calling thread; asking for more workers raises an
+        exception.
+
+        \warning the builder is called concurrently from different
+                 threads and must not modify shared data.  The objects
+                 it returns must not be shared between copies, with
+                 the exception of immutable ones such as day counters.
+                 Calendars can be shared, even if compiled: their
+                 tables of business days are built while holding a
+                 lock and read safely from any thread.  However,
+                 holidays must not be added or removed while the
+                 scenarios are evaluated.
+    */
+    class ScenarioEngine {
+      public:
+        //! market quotes and instruments, as built for a worker
+        struct Portfolio {
+            std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+            std::vector<boost::shared_ptr<Instrument> > instruments;
+        };
+        //! builder of independent copies of the portfolio
+        class Builder {
+          public:
+            virtual ~Builder() {}
+            virtual Portfolio build() const = 0;
+        };
+        ScenarioEngine(const boost::shared_ptr<Builder>& builder,
+                       Size workers = 1);
+        /*! Returns the changes in the NPVs of the instruments; the
+            element \f$ (i,j) \f$ is the change for the j-th
+            instrument under the i-th scenario, that is, the i-th row
+            of the shifts.
+        */
+        Disposable<Matrix> results(const Matrix& shifts) const;
+        Size workers() const { return workers_; }
+      private:
+        boost::shared_ptr<Builder> builder_;
+        Size workers_;
+    };
+
+}
+
+#endif
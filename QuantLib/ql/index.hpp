@@ -30,6 +30,7 @@
 #include <ql/time/calendar.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/indexes/indexmanager.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -86,25 +87,52 @@ namespace QuantLib {
                         ValueIterator vBegin,
                         bool forceOverwrite = false) {
             std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
+            const TimeSeries<Real>& h =
+                IndexManager::instance().getHistory(tag);
+            // the accepted fixings are stored all together at the end
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            // positions of the accepted fixings; they're only needed
+            // (and collected) when the dates are not increasing
+            std::map<Date, Size> positions;
+            Date latestDate;
             bool missingFixing, validFixing;
             bool noInvalidFixing = true, noDuplicatedFixing = true;
             Date invalidDate, duplicatedDate;
             Real nullValue = Null<Real>();
             Real invalidValue = Null<Real>();
             Real duplicatedValue = Null<Real>();
+            Real presentValue = Null<Real>();
             while (dBegin != dEnd) {
                 validFixing = isValidFixingDate(*dBegin);
-                Real currentValue = h[*dBegin];
+                Real currentValue = nullValue;
+                if (!dates.empty() && *dBegin <= latestDate) {
+                    if (positions.empty()) {
+                        for (Size i=0; i<dates.size(); ++i)
+                            positions[dates[i]] = i;
+                    }
+                    std::map<Date, Size>::const_iterator p =
+                        positions.find(*dBegin);
+                    if (p != positions.end())
+                        currentValue = values[p->second];
+                }
+                if (currentValue == nullValue)
+                    currentValue = h[*dBegin];
                 missingFixing = forceOverwrite || currentValue == nullValue;
                 if (validFixing) {
-                    if (missingFixing)
-                        h[*(dBegin++)] = *(vBegin++);
-                    else if (close(currentValue,*(vBegin))) {
+                    if (missingFixing) {
+                        if (!positions.empty())
+                            positions[*dBegin] = dates.size();
+                        if (dates.empty() || *dBegin > latestDate)
+                            latestDate = *dBegin;
+                        dates.push_back(*(dBegin++));
+                        values.push_back(*(vBegin++));
+                    } else if (close(currentValue,*(vBegin))) {
                         ++dBegin;
                         ++vBegin;
                     } else {
                         noDuplicatedFixing = false;
+                        presentValue = currentValue;
                         duplicatedDate = *(dBegin++);
                         duplicatedValue = *(vBegin++);
                     }
@@ -114,7 +142,7 @@ namespace QuantLib {
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            IndexManager::instance().addFixings(tag, dates, values);
             QL_REQUIRE(noInvalidFixing,
                        "At least one invalid fixing provided: " <<
                        invalidDate.weekday() << " " << invalidDate <<
@@ -122,7 +150,7 @@ namespace QuantLib {
             QL_REQUIRE(noDuplicatedFixing,
                        "At least one duplicated fixing provided: " <<
                        duplicatedDate << ", " << duplicatedValue <<
-                       " while " << h[duplicatedDate] <<
+                       " while " << presentValue <<
                        " value is already present");
         }
         //! clears all stored historical fixings
@@ -35,20 +35,56 @@ namespace QuantLib {
                          const Handle<YieldTermStructure>& h)
     : InterestRateIndex(familyName, tenor, settlementDays, currency,
                         fixingCalendar, dayCounter),
-      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth) {
+      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth),
+      holidayGeneration_(fixingCalendar.generation()) {
         registerWith(termStructure_);
       }
 
-    Rate IborIndex::forecastFixing(const Date& fixingDate) const {
-        Date d1 = valueDate(fixingDate);
-        Date d2 = maturityDate(d1);
-        Time t = dayCounter_.yearFraction(d1, d2);
-        QL_REQUIRE(t>0.0,
+    const IborIndex::FixingPeriod&
+    IborIndex::fixingPeriod(const Date& fixingDate) const {
+        unsigned long generation = fixingCalendar().generation();
+        if (holidayGeneration_ != generation) {
+            fixingPeriods_.clear();
+            forecasts_.clear();
+            holidayGeneration_ = generation;
+        }
+        if (fixingPeriods_.size() >= maxMemoSize)
+            fixingPeriods_.clear();
+        std::map<Date, FixingPeriod>::iterator i =
+            fixingPeriods_.lower_bound(fixingDate);
+        if (i != fixingPeriods_.end() && i->first == fixingDate)
+            return i->second;
+
+        FixingPeriod p;
+        p.valueDate = valueDate(fixingDate);
+        p.maturityDate = maturityDate(p.valueDate);
+        p.t = dayCounter_.yearFraction(p.valueDate, p.maturityDate);
+        QL_REQUIRE(p.t>0.0,
                    "\n cannot calculate forward rate between " <<
-                   d1 << " and " << d2 <<
-                   ":\n non positive time (" << t <<
+                   p.valueDate << " and " << p.maturityDate <<
+                   ":\n non positive time (" << p.t <<
                    ") using " << dayCounter_.name() << " daycounter");
-        return forecastFixing(d1, d2, t);
+        return fixingPeriods_.insert(i, std::make_pair(fixingDate, p))->second;
+    }
+
+    Rate IborIndex::forecastFixing(const Date& fixingDate) const {
+        const FixingPeriod& p = fixingPeriod(fixingDate);
+        if (!termStructure_.forwardsNotifications())
+            return forecastFixing(p.valueDate, p.maturityDate, p.t);
+        if (forecasts_.size() >= maxMemoSize)
+            forecasts_.clear();
+        std::map<Date, Rate>::iterator i = forecasts_.lower_bound(fixingDate);
+        if (i != forecasts_.end() && i->first == fixingDate)
+            return i->second;
+        Rate r = forecastFixing(p.valueDate, p.maturityDate, p.t);
+        forecasts_.insert(i, std::make_pair(fixingDate, r));
+        return r;
+    }
+
+    void IborIndex::update() {
+        forecasts_.clear();
+        periodForecasts_.clear();
+        InterestRateIndex::update();
     }
 
     Date IborIndex::maturityDate(const Date& valueDate) const {
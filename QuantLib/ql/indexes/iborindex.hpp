@@ -28,6 +28,7 @@
 
 #include <ql/indexes/interestrateindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -56,6 +57,10 @@ namespace QuantLib {
         //! the curve used to forecast fixings
         Handle<YieldTermStructure> forwardingTermStructure() const;
         //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
         //! \name Other methods
         //@{
         //! returns a copy of itself linked to a different forwarding curve
@@ -67,6 +72,31 @@ namespace QuantLib {
         Handle<YieldTermStructure> termStructure_;
         bool endOfMonth_;
       private:
+        struct FixingPeriod {
+            Date valueDate, maturityDate;
+            Time t;
+        };
+        const FixingPeriod& fixingPeriod(const Date& fixingDate) const;
+        /* Forecasts are memoized by fixing date and by (value date,
+           end date) pair, so that coupons and instruments sharing the
+           index compute each forward once.  They are cleared whenever
+           the forwarding curve (or the evaluation date) notifies a
+           change; the fixing periods only depend on the calendar and
+           are kept until its holidays are modified.
+
+           Forecasts are not memoized when the handle doesn't forward
+           the notifications of the curve, as in the indexes used by
+           rate helpers: the curve data change during bootstrapping
+           without notifications being sent.
+
+           Each memo is emptied when it reaches maxMemoSize entries,
+           so that the memory used by long-lived indexes stays bounded.
+        */
+        static const Size maxMemoSize = 5000;
+        mutable std::map<Date, FixingPeriod> fixingPeriods_;
+        mutable unsigned long holidayGeneration_;
+        mutable std::map<Date, Rate> forecasts_;
+        mutable std::map<std::pair<Date,Date>, Rate> periodForecasts_;
         // overload to avoid date/time (re)calculation
         /* This can be called with cached coupon dates (and it does
            give quite a performance boost to coupon calculations) but
@@ -108,9 +138,23 @@ namespace QuantLib {
                                           Time t) const {
         QL_REQUIRE(!termStructure_.empty(),
                    "null term structure set to this instance of " << name());
+        if (!termStructure_.forwardsNotifications()) {
+            DiscountFactor disc1 = termStructure_->discount(d1);
+            DiscountFactor disc2 = termStructure_->discount(d2);
+            return (disc1/disc2 - 1.0) / t;
+        }
+        if (periodForecasts_.size() >= maxMemoSize)
+            periodForecasts_.clear();
+        std::pair<Date,Date> key(d1, d2);
+        std::map<std::pair<Date,Date>, Rate>::iterator i =
+            periodForecasts_.lower_bound(key);
+        if (i != periodForecasts_.end() && i->first == key)
+            return i->second;
         DiscountFactor disc1 = termStructure_->discount(d1);
         DiscountFactor disc2 = termStructure_->discount(d2);
-        return (disc1/disc2 - 1.0) / t;
+        Rate r = (disc1/disc2 - 1.0) / t;
+        periodForecasts_.insert(i, std::make_pair(key, r));
+        return r;
     }
 
 }
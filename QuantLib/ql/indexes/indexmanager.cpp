@@ -31,17 +31,37 @@ namespace QuantLib {
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        return data_[to_upper_copy(name)].fixings;
     }
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        History& h = data_[to_upper_copy(name)];
+        h.fixings = history;
+        h.version = ++lastVersion_;
+        h.notifier->notifyObservers();
+    }
+
+    void IndexManager::addFixings(const string& name,
+                                  const std::vector<Date>& dates,
+                                  const std::vector<Real>& values) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "mismatch between number of dates (" << dates.size()
+                   << ") and fixings (" << values.size() << ")");
+        History& h = data_[to_upper_copy(name)];
+        h.fixings.insert(dates.begin(), dates.end(), values.begin());
+        h.version = ++lastVersion_;
+        h.notifier->notifyObservers();
     }
 
     boost::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return data_[to_upper_copy(name)].notifier;
+    }
+
+    unsigned long IndexManager::version(const string& name) const {
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        return i != data_.end() ? i->second.version : 0;
     }
 
     std::vector<string> IndexManager::histories() const {
@@ -26,7 +26,7 @@
 
 #include <ql/timeseries.hpp>
 #include <ql/patterns/singleton.hpp>
-#include <ql/utilities/observablevalue.hpp>
+#include <ql/patterns/observable.hpp>
 
 
 namespace QuantLib {
@@ -36,7 +36,7 @@ namespace QuantLib {
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
-        IndexManager() {}
+        IndexManager() : lastVersion_(0) {}
       public:
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
@@ -44,8 +44,22 @@ namespace QuantLib {
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
+        //! adds the given fixings to the history of the index
+        /*! Existing fixings at the same dates are overwritten.  The
+            history is modified in place and its observers are
+            notified once for the whole set; appending fixings sorted
+            by date takes constant time per fixing.
+        */
+        void addFixings(const std::string& name,
+                        const std::vector<Date>& dates,
+                        const std::vector<Real>& values);
         //! observer notifying of changes in the index fixings
         boost::shared_ptr<Observable> notifier(const std::string& name) const;
+        /*! returns a number that changes whenever the fixings of the
+            index are modified; it can be used by classes caching
+            results based on them.
+        */
+        unsigned long version(const std::string& name) const;
         //! returns all names of the indexes for which fixings were stored
         std::vector<std::string> histories() const;
         //! clears the historical fixings of the index
@@ -53,9 +67,19 @@ namespace QuantLib {
         //! clears all stored fixings
         void clearHistories();
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
-                                                                  history_map;
+        // the history is kept together with its notifier, instead
+        // of inside an ObservableValue, so that it can be modified
+        // in place rather than reassigned.
+        struct History {
+            History() : notifier(new Observable), version(0) {}
+            TimeSeries<Real> fixings;
+            boost::shared_ptr<Observable> notifier;
+            unsigned long version;
+        };
+        typedef std::map<std::string, History> history_map;
         mutable history_map data_;
+        // versions are never reused, even after clearing a history
+        unsigned long lastVersion_;
     };
 
 }
@@ -35,7 +35,6 @@ namespace QuantLib {
       frequency_(frequency), availabilityLag_(availabilityLag),
       currency_(currency) {
         name_ = region_.name() + " " + familyName_;
-        registerWith(Settings::instance().evaluationDate());
         registerWith(IndexManager::instance().notifier(name()));
     }
 
@@ -36,6 +36,10 @@ namespace QuantLib {
     class YoYInflationTermStructure;
 
     //! Base class for inflation-rate indexes,
+    /*! As for interest-rate indexes, changes of the evaluation date
+        are not notified by the index; observers depending on it
+        must register with it directly.
+    */
     class InflationIndex : public Index, public Observer {
       public:
         /*! An inflation index may return interpolated
@@ -54,7 +54,6 @@ namespace QuantLib {
         out << " " << dayCounter_.name();
         name_ = out.str();
 
-        registerWith(Settings::instance().evaluationDate());
         registerWith(IndexManager::instance().notifier(name()));
     }
 
@@ -35,7 +35,14 @@
 namespace QuantLib {
 
     //! base class for interest rate indexes
-    /*! \todo add methods returning InterestRate */
+    /*! Changes of the evaluation date are not notified by the
+        index, so that they're not forwarded through each of the
+        coupons observing it.  Observers whose results depend on
+        the evaluation date (e.g., instruments) must register with
+        it directly.
+
+        \todo add methods returning InterestRate
+    */
     class InterestRateIndex : public Index,
                               public Observer {
       public:
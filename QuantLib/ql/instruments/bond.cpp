@@ -29,6 +29,7 @@
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <boost/make_shared.hpp>
 
 using boost::shared_ptr;
 using boost::dynamic_pointer_cast;
@@ -311,10 +312,11 @@ namespace QuantLib {
             Real amount = (R/100.0)*(notionals_[i-1]-notionals_[i]);
             shared_ptr<CashFlow> payment;
             if (i < notionalSchedule_.size()-1)
-                payment.reset(new AmortizingPayment(amount,
-                                                    notionalSchedule_[i]));
+                payment = boost::make_shared<AmortizingPayment>(
+                                                amount, notionalSchedule_[i]);
             else
-                payment.reset(new Redemption(amount, notionalSchedule_[i]));
+                payment = boost::make_shared<Redemption>(
+                                                amount, notionalSchedule_[i]);
             cashflows_.push_back(payment);
             redemptions_.push_back(payment);
         }
@@ -328,8 +330,8 @@ namespace QuantLib {
                                    Real redemption,
                                    const Date& date) {
 
-        shared_ptr<CashFlow> redemptionCashflow(
-                         new Redemption(notional*redemption/100.0, date));
+        shared_ptr<CashFlow> redemptionCashflow =
+            boost::make_shared<Redemption>(notional*redemption/100.0, date);
         setSingleRedemption(notional, redemptionCashflow);
     }
 
@@ -67,7 +67,8 @@ namespace QuantLib {
                                                  Real accuracy,
                                                  Natural maxEvaluations,
                                                  Volatility minVol,
-                                                 Volatility maxVol) {
+                                                 Volatility maxVol,
+                                                 Volatility guess) {
 
             instrument.setupArguments(engine.getArguments());
             engine.getArguments()->validate();
@@ -75,10 +76,15 @@ namespace QuantLib {
             PriceError f(engine, volQuote, targetValue);
             Brent solver;
             solver.setMaxEvaluations(maxEvaluations);
-            Volatility guess = (minVol+maxVol)/2.0;
-            Volatility result = solver.solve(f, accuracy, guess,
-                                             minVol, maxVol);
-            return result;
+            if (guess == Null<Real>() || guess <= minVol || guess >= maxVol) {
+                guess = (minVol+maxVol)/2.0;
+                return solver.solve(f, accuracy, guess, minVol, maxVol);
+            } else {
+                solver.setLowerBound(minVol);
+                solver.setUpperBound(maxVol);
+                Real step = std::max(0.05*guess, 10.0*accuracy);
+                return solver.solve(f, accuracy, guess, step);
+            }
         }
 
         boost::shared_ptr<GeneralizedBlackScholesProcess>
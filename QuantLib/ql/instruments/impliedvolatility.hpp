@@ -36,6 +36,11 @@ namespace QuantLib {
         /*! The passed engine must be linked to the passed quote (see,
              e.g., VanillaOption to see how this can be achieved.)
 
+             If a guess is passed, the root is bracketed starting
+             from it instead of evaluating the engine at the minimum
+             and maximum volatility; this saves engine calculations
+             when the guess is close to the solution.
+
              \note this function is meant for developers of option
                    classes so that they can implement an
                    impliedVolatility() method.
@@ -49,7 +54,8 @@ namespace QuantLib {
                                         Real accuracy,
                                         Natural maxEvaluations,
                                         Volatility minVol,
-                                        Volatility maxVol);
+                                        Volatility maxVol,
+                                        Volatility guess = Null<Real>());
             // utilities
 
             /*! The returned process is equal to the passed one, except
@@ -23,7 +23,7 @@
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/indexes/iborindex.hpp>
-#include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/currencies/europe.hpp>
 
 namespace QuantLib {
@@ -49,6 +49,7 @@ namespace QuantLib {
       floatFirstDate_(Date()), floatNextToLastDate_(Date()),
       floatSpread_(0.0),
       floatDayCount_(index->dayCounter()),
+      cachedSchedules_(false),
       engine_(new DiscountingSwapEngine(iborIndex_->forwardingTermStructure(),
                                         false))
     {
@@ -91,19 +92,38 @@ namespace QuantLib {
                 fixedTenor = Period(1, Years);
         }
 
-        Schedule fixedSchedule(startDate, endDate,
+        boost::shared_ptr<const Schedule> fixedSchedule, floatSchedule;
+        if (cachedSchedules_) {
+            fixedSchedule = ScheduleCache::instance().schedule(
+                               startDate, endDate,
                                fixedTenor, fixedCalendar_,
                                fixedConvention_,
                                fixedTerminationDateConvention_,
                                fixedRule_, fixedEndOfMonth_,
                                fixedFirstDate_, fixedNextToLastDate_);
-
-        Schedule floatSchedule(startDate, endDate,
+            floatSchedule = ScheduleCache::instance().schedule(
+                               startDate, endDate,
                                floatTenor_, floatCalendar_,
                                floatConvention_,
                                floatTerminationDateConvention_,
                                floatRule_, floatEndOfMonth_,
                                floatFirstDate_, floatNextToLastDate_);
+        } else {
+            fixedSchedule = boost::shared_ptr<const Schedule>(
+                      new Schedule(startDate, endDate,
+                                   fixedTenor, fixedCalendar_,
+                                   fixedConvention_,
+                                   fixedTerminationDateConvention_,
+                                   fixedRule_, fixedEndOfMonth_,
+                                   fixedFirstDate_, fixedNextToLastDate_));
+            floatSchedule = boost::shared_ptr<const Schedule>(
+                      new Schedule(startDate, endDate,
+                                   floatTenor_, floatCalendar_,
+                                   floatConvention_,
+                                   floatTerminationDateConvention_,
+                                   floatRule_, floatEndOfMonth_,
+                                   floatFirstDate_, floatNextToLastDate_));
+        }
 
         DayCounter fixedDayCount;
         if (fixedDayCount_ != DayCounter())
@@ -185,6 +205,11 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeVanillaSwap& MakeVanillaSwap::withCachedSchedules(bool flag) {
+        cachedSchedules_ = flag;
+        return *this;
+    }
+
     MakeVanillaSwap& MakeVanillaSwap::withPricingEngine(
                              const boost::shared_ptr<PricingEngine>& engine) {
         engine_ = engine;
@@ -80,6 +80,11 @@ namespace QuantLib {
                               const Handle<YieldTermStructure>& discountCurve);
         MakeVanillaSwap& withPricingEngine(
                               const boost::shared_ptr<PricingEngine>& engine);
+        /*! If set, the schedules of the swap are retrieved from (and
+            stored into) the ScheduleCache, so that swaps with the same
+            dates and conventions share them.
+        */
+        MakeVanillaSwap& withCachedSchedules(bool flag = true);
       private:
         Period swapTenor_;
         boost::shared_ptr<IborIndex> iborIndex_;
@@ -100,6 +105,7 @@ namespace QuantLib {
         Date floatFirstDate_, floatNextToLastDate_;
         Spread floatSpread_;
         DayCounter fixedDayCount_, floatDayCount_;
+        bool cachedSchedules_;
 
         boost::shared_ptr<PricingEngine> engine_;
     };
@@ -23,6 +23,7 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/settings.hpp>
 
 namespace QuantLib {
 
@@ -40,6 +41,7 @@ namespace QuantLib {
             registerWith(*i);
         for (Leg::iterator i = legs_[1].begin(); i!= legs_[1].end(); ++i)
             registerWith(*i);
+        registerWith(Settings::instance().evaluationDate());
     }
 
     Swap::Swap(const std::vector<Leg>& legs,
@@ -56,13 +58,16 @@ namespace QuantLib {
             for (Leg::iterator i = legs_[j].begin(); i!= legs_[j].end(); ++i)
                 registerWith(*i);
         }
+        registerWith(Settings::instance().evaluationDate());
     }
 
     Swap::Swap(Size legs)
     : legs_(legs), payer_(legs),
       legNPV_(legs, 0.0), legBPS_(legs, 0.0),
       startDiscounts_(legs, 0.0), endDiscounts_(legs, 0.0),
-      npvDateDiscount_(0.0) {}
+      npvDateDiscount_(0.0) {
+        registerWith(Settings::instance().evaluationDate());
+    }
 
 
     bool Swap::isExpired() const {
@@ -24,11 +24,49 @@
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdbermudanengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/exercise.hpp>
 #include <boost/scoped_ptr.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Black volatility giving the target value to a European
+           option with the same payoff and last exercise date, as
+           AnalyticEuropeanEngine would price it; Null<Real>() if
+           no such volatility can be found. */
+        Volatility blackImpliedVolatility(
+             const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+             const Date& exerciseDate,
+             Real targetValue,
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Real accuracy,
+             Size maxEvaluations) {
+            Time t = process->blackVolatility()->timeFromReference(
+                                                                exerciseDate);
+            Real spot = process->stateVariable()->value();
+            if (t <= 0.0 || spot <= 0.0)
+                return Null<Real>();
+            DiscountFactor discount =
+                process->riskFreeRate()->discount(exerciseDate);
+            Real forward = spot *
+                process->dividendYield()->discount(exerciseDate) / discount;
+            try {
+                Real stdDev = blackFormulaImpliedStdDev(
+                                   payoff, forward, targetValue, discount,
+                                   0.0, Null<Real>(), accuracy*std::sqrt(t),
+                                   maxEvaluations);
+                return stdDev/std::sqrt(t);
+            } catch (std::exception&) {
+                // e.g., no time value left; let the caller fall back
+                // to the numerical solution
+                return Null<Real>();
+            }
+        }
+
+    }
+
     VanillaOption::VanillaOption(
         const boost::shared_ptr<StrikedTypePayoff>& payoff,
         const boost::shared_ptr<Exercise>& exercise)
@@ -45,6 +83,26 @@ namespace QuantLib {
 
         QL_REQUIRE(!isExpired(), "option expired");
 
+        // The Black formula can be inverted directly for European
+        // options, and gives a close guess for the others since the
+        // early-exercise premium is usually small.
+        Volatility guess = Null<Real>();
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(payoff_);
+        if (payoff) {
+            guess = blackImpliedVolatility(payoff, exercise_->lastDate(),
+                                           targetValue, process,
+                                           accuracy, maxEvaluations);
+            if (exercise_->type() == Exercise::European
+                && guess != Null<Real>()) {
+                QL_REQUIRE(guess >= minVol && guess <= maxVol,
+                           "implied volatility (" << guess
+                           << ") outside the given range ["
+                           << minVol << ", " << maxVol << "]");
+                return guess;
+            }
+        }
+
         boost::shared_ptr<SimpleQuote> volQuote(new SimpleQuote);
 
         boost::shared_ptr<GeneralizedBlackScholesProcess> newProcess =
@@ -72,7 +130,8 @@ namespace QuantLib {
                                                           targetValue,
                                                           accuracy,
                                                           maxEvaluations,
-                                                          minVol, maxVol);
+                                                          minVol, maxVol,
+                                                          guess);
     }
 
 }
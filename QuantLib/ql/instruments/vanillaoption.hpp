@@ -42,7 +42,8 @@ namespace QuantLib {
         /*! \warning currently, this method returns the Black-Scholes
                      implied volatility using analytic formulas for
                      European options and a finite-difference method
-                     for American and Bermudan options. It will give
+                     for American and Bermudan options (starting from
+                     the European implied volatility, if any.) It will give
                      unconsistent results if the pricing was performed
                      with any other methods (such as jump-diffusion
                      models.)
@@ -80,6 +80,21 @@ namespace QuantLib {
             const DayCounter& floatingDayCount,
             boost::optional<BusinessDayConvention> paymentConvention =
                                                                  boost::none);
+        /*! The schedules are shared and not copied; this allows
+            swaps to use the schedules stored in the ScheduleCache.
+        */
+        VanillaSwap(
+            Type type,
+            Real nominal,
+            const boost::shared_ptr<const Schedule>& fixedSchedule,
+            Rate fixedRate,
+            const DayCounter& fixedDayCount,
+            const boost::shared_ptr<const Schedule>& floatSchedule,
+            const boost::shared_ptr<IborIndex>& iborIndex,
+            Spread spread,
+            const DayCounter& floatingDayCount,
+            boost::optional<BusinessDayConvention> paymentConvention =
+                                                                 boost::none);
         //! \name Inspectors
         //@{
         Type type() const;
@@ -114,13 +129,14 @@ namespace QuantLib {
         void setupArguments(PricingEngine::arguments* args) const;
         void fetchResults(const PricingEngine::results*) const;
       private:
+        void initialize(boost::optional<BusinessDayConvention>);
         void setupExpired() const;
         Type type_;
         Real nominal_;
-        Schedule fixedSchedule_;
+        boost::shared_ptr<const Schedule> fixedSchedule_;
         Rate fixedRate_;
         DayCounter fixedDayCount_;
-        Schedule floatingSchedule_;
+        boost::shared_ptr<const Schedule> floatingSchedule_;
         boost::shared_ptr<IborIndex> iborIndex_;
         Spread spread_;
         DayCounter floatingDayCount_;
@@ -175,7 +191,7 @@ namespace QuantLib {
     }
 
     inline const Schedule& VanillaSwap::fixedSchedule() const {
-        return fixedSchedule_;
+        return *fixedSchedule_;
     }
 
     inline Rate VanillaSwap::fixedRate() const {
@@ -187,7 +203,7 @@ namespace QuantLib {
     }
 
     inline const Schedule& VanillaSwap::floatingSchedule() const {
-        return floatingSchedule_;
+        return *floatingSchedule_;
     }
 
     inline const boost::shared_ptr<IborIndex>& VanillaSwap::iborIndex() const {
@@ -28,11 +28,47 @@
 
 #include <ql/math/interpolations/extrapolation.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/array.hpp>
 #include <ql/errors.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        /* Returns the index i of the interval [x_i, x_{i+1}) containing
+           x, as found by a binary search (with the first and last
+           interval extending to infinity.)  Most queries follow the
+           previous one closely; therefore, the search starts from the
+           hint (i.e., the last result) and walks forward a few
+           intervals before falling back to bisection. This way,
+           sorted queries are located in a single pass. */
+        template <class I>
+        Size locateFromHint(const I& xBegin, const I& xEnd, Real x,
+                            Size& hint) {
+            Size n = xEnd-xBegin;
+            if (x < *xBegin)
+                return 0;
+            else if (x > *(xEnd-1))
+                return n-2;
+            Size i = hint;
+            if (i < n-1 && xBegin[i] <= x) {
+                Size last = std::min<Size>(i+4, n-2);
+                while (i < last && !(x < xBegin[i+1]))
+                    ++i;
+                if (i == n-2 || x < xBegin[i+1])
+                    hint = i;
+                else
+                    hint = std::upper_bound(xBegin+i+1,xEnd-1,x)-xBegin-1;
+            } else {
+                hint = std::upper_bound(xBegin,xEnd-1,x)-xBegin-1;
+            }
+            return hint;
+        }
+
+    }
+
     //! base class for 1-D interpolations.
     /*! Classes derived from this class will provide interpolated
         values from two sequences of equal length, representing
@@ -55,6 +91,10 @@ namespace QuantLib {
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
+            virtual void values(const Array& x, Array& y) const {
+                for (Size i=0; i<x.size(); ++i)
+                    y[i] = value(x[i]);
+            }
         };
         boost::shared_ptr<Impl> impl_;
       public:
@@ -65,7 +105,7 @@ namespace QuantLib {
         class templateImpl : public Impl {
           public:
             templateImpl(const I1& xBegin, const I1& xEnd, const I2& yBegin)
-            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin) {
+            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin), hint_(0) {
                 QL_REQUIRE(static_cast<int>(xEnd_-xBegin_) >= 2,
                            "not enough points to interpolate: at least 2 "
                            "required, " << static_cast<int>(xEnd_-xBegin_)<< " provided");
@@ -96,15 +136,12 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                return detail::locateFromHint(xBegin_, xEnd_, x, hint_);
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
+          private:
+            mutable Size hint_;
         };
       public:
         Interpolation() {}
@@ -114,6 +151,24 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        //! interpolated values at the given points
+        /*! This is equivalent to calling operator() for each point,
+            but saves a virtual call for each of them; besides, sorted
+            points are located in a single pass.  The result array is
+            resized if needed.
+        */
+        void values(const Array& x, Array& y,
+                    bool allowExtrapolation = false) const {
+            if (y.size() != x.size())
+                y = Array(x.size());
+            if (x.empty())
+                return;
+            checkRange(*std::min_element(x.begin(), x.end()),
+                       allowExtrapolation);
+            checkRange(*std::max_element(x.begin(), x.end()),
+                       allowExtrapolation);
+            impl_->values(x, y);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -56,6 +56,10 @@ namespace QuantLib {
                 else
                     return this->yBegin_[i+1];
             }
+            void values(const Array& x, Array& y) const {
+                for (Size i=0; i<x.size(); ++i)
+                    y[i] = BackwardFlatInterpolationImpl::value(x[i]);
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -77,6 +77,26 @@ namespace QuantLib {
                                           CubicInterpolation::SecondDerivative, 0.0);
                 return spline(y,true);
             }
+            void values(const Array& x, const Array& y, Array& z) const {
+                std::vector<Real> section(splines_.size());
+                Size i = 0;
+                while (i < x.size()) {
+                    // the section in y is reused for equal x values
+                    for (Size k=0; k<splines_.size(); k++)
+                        section[k]=splines_[k](x[i],true);
+                    CubicInterpolation spline(this->yBegin_, this->yEnd_,
+                                          section.begin(),
+                                          CubicInterpolation::Spline, false,
+                                          CubicInterpolation::SecondDerivative, 0.0,
+                                          CubicInterpolation::SecondDerivative, 0.0);
+                    Size j = i;
+                    do {
+                        z[j] = spline(y[j],true);
+                        ++j;
+                    } while (j < x.size() && x[j] == x[i]);
+                    i = j;
+                }
+            }
             
             Real derivativeX(Real x, Real y) const {
                 std::vector<Real> section(this->zData_.columns());
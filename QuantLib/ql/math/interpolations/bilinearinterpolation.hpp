@@ -60,6 +60,10 @@ namespace QuantLib {
                 return (1.0-t)*(1.0-u)*z1 + t*(1.0-u)*z2
                      + (1.0-t)*u*z3 + t*u*z4;
             }
+            void values(const Array& x, const Array& y, Array& z) const {
+                for (Size i=0; i<x.size(); ++i)
+                    z[i] = BilinearInterpolationImpl::value(x[i], y[i]);
+            }
         };
 
     }
@@ -695,6 +695,10 @@ namespace QuantLib {
                 Real dx_ = x-this->xBegin_[j];
                 return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
             }
+            void values(const Array& x, Array& y) const {
+                for (Size i=0; i<x.size(); ++i)
+                    y[i] = CubicInterpolationImpl::value(x[i]);
+            }
             Real primitive(Real x) const {
                 Size j = this->locate(x);
                 Real dx_ = x-this->xBegin_[j];
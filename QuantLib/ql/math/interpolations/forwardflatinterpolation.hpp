@@ -53,6 +53,10 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i];
             }
+            void values(const Array& x, Array& y) const {
+                for (Size i=0; i<x.size(); ++i)
+                    y[i] = ForwardFlatInterpolationImpl::value(x[i]);
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -25,8 +25,7 @@
 #ifndef quantlib_interpolation2D_hpp
 #define quantlib_interpolation2D_hpp
 
-#include <ql/math/interpolations/extrapolation.hpp>
-#include <ql/math/comparison.hpp>
+#include <ql/math/interpolation.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
@@ -59,6 +58,11 @@ namespace QuantLib {
             virtual const Matrix& zData() const = 0;
             virtual bool isInRange(Real x, Real y) const = 0;
             virtual Real value(Real x, Real y) const = 0;
+            virtual void values(const Array& x, const Array& y,
+                                Array& z) const {
+                for (Size i=0; i<x.size(); ++i)
+                    z[i] = value(x[i], y[i]);
+            }
         };
         boost::shared_ptr<Impl> impl_;
       public:
@@ -73,7 +77,7 @@ namespace QuantLib {
                          const I2& yBegin, const I2& yEnd,
                          const M& zData)
             : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin), yEnd_(yEnd),
-              zData_(zData) {
+              zData_(zData), hintX_(0), hintY_(0) {
                 QL_REQUIRE(xEnd_-xBegin_ >= 2,
                            "not enough x points to interpolate: at least 2 "
                            "required, " << xEnd_-xBegin_ << " provided");
@@ -126,28 +130,20 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                return detail::locateFromHint(xBegin_, xEnd_, x, hintX_);
             }
             Size locateY(Real y) const {
                 #if defined(QL_EXTRA_SAFETY_CHECKS)
                 for (I2 k=yBegin_, l=yBegin_+1; l!=yEnd_; ++k, ++l)
                     QL_REQUIRE(*l > *k, "unsorted y values");
                 #endif
-                if (y < *yBegin_)
-                    return 0;
-                else if (y > *(yEnd_-1))
-                    return yEnd_-yBegin_-2;
-                else
-                    return std::upper_bound(yBegin_,yEnd_-1,y)-yBegin_-1;
+                return detail::locateFromHint(yBegin_, yEnd_, y, hintY_);
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_, yEnd_;
             const M& zData_;
+          private:
+            mutable Size hintX_, hintY_;
         };
       public:
         Interpolation2D() {}
@@ -156,6 +152,27 @@ namespace QuantLib {
             checkRange(x,y,allowExtrapolation);
             return impl_->value(x,y);
         }
+        //! interpolated values at the given points
+        /*! The result array is resized if needed.
+            \pre x and y must have the same size.
+        */
+        void values(const Array& x, const Array& y, Array& z,
+                    bool allowExtrapolation = false) const {
+            QL_REQUIRE(x.size() == y.size(),
+                       "size mismatch between x (" << x.size()
+                       << ") and y (" << y.size() << ") values");
+            if (z.size() != x.size())
+                z = Array(x.size());
+            if (x.empty())
+                return;
+            checkRange(*std::min_element(x.begin(), x.end()),
+                       *std::min_element(y.begin(), y.end()),
+                       allowExtrapolation);
+            checkRange(*std::max_element(x.begin(), x.end()),
+                       *std::max_element(y.begin(), y.end()),
+                       allowExtrapolation);
+            impl_->values(x, y, z);
+        }
         Real xMin() const {
             return impl_->xMin();
         }
@@ -58,6 +58,11 @@ namespace QuantLib {
             Real value(Real x) const {
                 return std::exp(interpolation_(x, true));
             }
+            void values(const Array& x, Array& y) const {
+                interpolation_.values(x, y, true);
+                for (Size i=0; i<y.size(); ++i)
+                    y[i] = std::exp(y[i]);
+            }
             Real primitive(Real) const {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
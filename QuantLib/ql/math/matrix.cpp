@@ -39,6 +39,102 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // elements of a block: 128x128 doubles take 128 KB
+        const Size blockSize = 128;
+        // elements of a tile in transpose(): 32x32 doubles take 8 KB
+        const Size tileSize = 32;
+
+        /* adds a[k]*b[k][j] to r[j] for k in [k0,k1) and j in [j0,j1).
+           Four rows of b are processed at a time, which saves loads and
+           stores of r; the terms are still added in order of k. */
+        void accumulateProducts(Matrix::row_iterator r,
+                                Matrix::const_row_iterator a,
+                                const Matrix& b,
+                                Size k0, Size k1, Size j0, Size j1) {
+            Size k = k0;
+            for (; k+4<=k1; k+=4) {
+                const Real a0 = a[k], a1 = a[k+1], a2 = a[k+2], a3 = a[k+3];
+                Matrix::const_row_iterator b0 = b.row_begin(k),
+                                           b1 = b.row_begin(k+1),
+                                           b2 = b.row_begin(k+2),
+                                           b3 = b.row_begin(k+3);
+                for (Size j=j0; j<j1; ++j)
+                    r[j] = (((r[j] + a0*b0[j]) + a1*b1[j])
+                                   + a2*b2[j]) + a3*b3[j];
+            }
+            for (; k<k1; ++k) {
+                const Real ak = a[k];
+                Matrix::const_row_iterator bk = b.row_begin(k);
+                for (Size j=j0; j<j1; ++j)
+                    r[j] += ak*bk[j];
+            }
+        }
+
+    }
+
+    const Disposable<Matrix> operator*(const Matrix& m1, const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        const Size rows = m1.rows(), inner = m1.columns(),
+                   columns = m2.columns();
+        Matrix result(rows, columns, 0.0);
+        // The inner index k runs over the blocks in increasing
+        // order, so that each element is still summed from the first
+        // term to the last.
+        for (Size jj=0; jj<columns; jj+=blockSize) {
+            const Size jEnd = std::min(jj+blockSize, columns);
+            for (Size kk=0; kk<inner; kk+=blockSize) {
+                const Size kEnd = std::min(kk+blockSize, inner);
+                for (Size i=0; i<rows; ++i)
+                    accumulateProducts(result.row_begin(i), m1.row_begin(i),
+                                       m2, kk, kEnd, jj, jEnd);
+            }
+        }
+        return result;
+    }
+
+    const Disposable<Matrix> transpose(const Matrix& m) {
+        const Size rows = m.rows(), columns = m.columns();
+        Matrix result(columns, rows);
+        for (Size ii=0; ii<rows; ii+=tileSize) {
+            const Size iEnd = std::min(ii+tileSize, rows);
+            for (Size jj=0; jj<columns; jj+=tileSize) {
+                const Size jEnd = std::min(jj+tileSize, columns);
+                for (Size i=ii; i<iEnd; ++i) {
+                    Matrix::const_row_iterator mi = m.row_begin(i);
+                    for (Size j=jj; j<jEnd; ++j)
+                        result[j][i] = mi[j];
+                }
+            }
+        }
+        return result;
+    }
+
+    const Disposable<Matrix> symmetricProduct(const Matrix& m) {
+        const Size rows = m.rows(), inner = m.columns();
+        const Matrix t = transpose(m);
+        Matrix result(rows, rows, 0.0);
+        // same as m*transpose(m) restricted to the lower triangle
+        for (Size jj=0; jj<rows; jj+=blockSize) {
+            const Size jEnd = std::min(jj+blockSize, rows);
+            for (Size kk=0; kk<inner; kk+=blockSize) {
+                const Size kEnd = std::min(kk+blockSize, inner);
+                for (Size i=jj; i<rows; ++i)
+                    accumulateProducts(result.row_begin(i), m.row_begin(i),
+                                       t, kk, kEnd, jj, std::min(jEnd, i+1));
+            }
+        }
+        for (Size i=0; i<rows; ++i)
+            for (Size j=0; j<i; ++j)
+                result[j][i] = result[i][j];
+        return result;
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
         #if !defined(QL_NO_UBLAS_SUPPORT)
 
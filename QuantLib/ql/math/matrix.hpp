@@ -151,7 +151,14 @@ namespace QuantLib {
     const Disposable<Array> operator*(const Array&, const Matrix&);
     /*! \relates Matrix */
     const Disposable<Array> operator*(const Matrix&, const Array&);
-    /*! \relates Matrix */
+    /*! The product is blocked so that the parts of the operands
+        being used stay in cache, and its innermost loop runs over
+        contiguous memory so that it can be vectorized by the
+        compiler.  For each element of the result, the terms are
+        summed in the same order as in the textbook algorithm.
+
+        \relates Matrix
+    */
     const Disposable<Matrix> operator*(const Matrix&, const Matrix&);
 
     // misc. operations
@@ -159,6 +166,13 @@ namespace QuantLib {
     /*! \relates Matrix */
     const Disposable<Matrix> transpose(const Matrix&);
 
+    /*! returns \f$ M M^T \f$, computing only one half of the
+        symmetric result.
+
+        \relates Matrix
+    */
+    const Disposable<Matrix> symmetricProduct(const Matrix& m);
+
     /*! \relates Matrix */
     const Disposable<Matrix> outerProduct(const Array& v1, const Array& v2);
 
@@ -500,11 +514,14 @@ namespace QuantLib {
                    "vectors and matrices with different sizes ("
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
                    ") cannot be multiplied");
-        Array result(m.columns());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),0.0);
+        // accumulate row by row, so that m is read contiguously
+        Array result(m.columns(), 0.0);
+        for (Size i=0; i<m.rows(); i++) {
+            const Real vi = v[i];
+            Matrix::const_row_iterator mi = m.row_begin(i);
+            for (Size j=0; j<result.size(); j++)
+                result[j] += vi*mi[j];
+        }
         return result;
     }
 
@@ -520,32 +537,6 @@ namespace QuantLib {
         return result;
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
-                                              const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-                   "matrices with different sizes (" <<
-                   m1.rows() << "x" << m1.columns() << ", " <<
-                   m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns());
-        for (Size i=0; i<result.rows(); i++)
-            for (Size j=0; j<result.columns(); j++)
-                result[i][j] =
-                    std::inner_product(m1.row_begin(i), m1.row_end(i),
-                                       m2.column_begin(j), 0.0);
-        return result;
-    }
-
-    inline const Disposable<Matrix> transpose(const Matrix& m) {
-        Matrix result(m.columns(),m.rows());
-        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-        if (!m.empty())
-        #endif
-        for (Size i=0; i<m.rows(); i++)
-            std::copy(m.row_begin(i),m.row_end(i),result.column_begin(i));
-        return result;
-    }
-
     inline const Disposable<Matrix> outerProduct(const Array& v1,
                                                  const Array& v2) {
         return outerProduct(v1.begin(), v1.end(), v2.begin(), v2.end());
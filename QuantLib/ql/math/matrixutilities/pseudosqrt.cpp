@@ -44,6 +44,19 @@ namespace QuantLib {
                                ", [" << j << "][" << i << "]=" << matrix[j][i]);
         }
 
+        // returns the first n columns of m, each multiplied by the
+        // corresponding element of d; same as m times the diagonal
+        // matrix built from d, without the cost of the product.
+        const Disposable<Matrix> scaledColumns(const Matrix& m,
+                                               const Array& d,
+                                               Size n) {
+            Matrix result(m.rows(), n);
+            for (Size i=0; i<m.rows(); ++i)
+                for (Size j=0; j<n; ++j)
+                    result[i][j] = m[i][j]*d[j];
+            return result;
+        }
+
         void normalizePseudoRoot(const Matrix& matrix,
                                  Matrix& pseudo) {
             Size size = matrix.rows();
@@ -74,15 +87,14 @@ namespace QuantLib {
             bool lowerDiagonal_;
             Matrix targetMatrix_;
             Array targetVariance_;
-            mutable Matrix currentRoot_, tempMatrix_, currentMatrix_;
+            mutable Matrix currentRoot_, currentMatrix_;
           public:
             HypersphereCostFunction(const Matrix& targetMatrix,
                                     const Array& targetVariance,
                                     bool lowerDiagonal)
             : size_(targetMatrix.rows()), lowerDiagonal_(lowerDiagonal),
               targetMatrix_(targetMatrix), targetVariance_(targetVariance),
-              currentRoot_(size_, size_), tempMatrix_(size_, size_),
-              currentMatrix_(size_, size_) {}
+              currentRoot_(size_, size_), currentMatrix_(size_, size_) {}
             Disposable<Array> values(const Array&) const {
                 QL_FAIL("values method not implemented");
             }
@@ -121,8 +133,7 @@ namespace QuantLib {
                     }
                 }
                 Real temp, error=0;
-                tempMatrix_ = transpose(currentRoot_);
-                currentMatrix_ = currentRoot_ * tempMatrix_;
+                currentMatrix_ = symmetricProduct(currentRoot_);
                 for (i=0;i<size_;i++) {
                     for (j=0;j<size_;j++) {
                         temp = currentMatrix_[i][j]*targetVariance_[i]
@@ -146,7 +157,7 @@ namespace QuantLib {
                 variance[i]=std::sqrt(targetMatrix[i][i]);
             }
             if (lowerDiagonal) {
-                Matrix approxMatrix(result*transpose(result));
+                Matrix approxMatrix(symmetricProduct(result));
                 result = CholeskyDecomposition(approxMatrix, true);
                 for (i=0; i<size; i++) {
                     for (j=0; j<size; j++) {
@@ -297,13 +308,14 @@ namespace QuantLib {
             QL_REQUIRE(size == M.columns(),
                        "matrix not square");
 
-            Matrix diagonal(size, size, 0.0);
             SymmetricSchurDecomposition jd(M);
+            Array eigenvalues(size);
             for (Size i=0; i<size; ++i)
-                diagonal[i][i] = std::max<Real>(jd.eigenvalues()[i], 0.0);
+                eigenvalues[i] = std::max<Real>(jd.eigenvalues()[i], 0.0);
 
             Matrix result =
-                jd.eigenvectors()*diagonal*transpose(jd.eigenvectors());
+                scaledColumns(jd.eigenvectors(), eigenvalues, size)
+                * transpose(jd.eigenvectors());
             return result;
         }
 
@@ -363,7 +375,7 @@ namespace QuantLib {
 
         // spectral (a.k.a Principal Component) analysis
         SymmetricSchurDecomposition jd(matrix);
-        Matrix diagonal(size, size, 0.0);
+        Array diagonal(size);
 
         // salvaging algorithm
         Matrix result(size, size);
@@ -380,21 +392,21 @@ namespace QuantLib {
           case SalvagingAlgorithm::Spectral:
             // negative eigenvalues set to zero
             for (Size i=0; i<size; i++)
-                diagonal[i][i] =
+                diagonal[i] =
                     std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
 
-            result = jd.eigenvectors() * diagonal;
+            result = scaledColumns(jd.eigenvectors(), diagonal, size);
             normalizePseudoRoot(matrix, result);
             break;
           case SalvagingAlgorithm::Hypersphere:
             // negative eigenvalues set to zero
             negative=false;
             for (Size i=0; i<size; ++i){
-                diagonal[i][i] =
+                diagonal[i] =
                     std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
                 if (jd.eigenvalues()[i]<0.0) negative=true;
             }
-            result = jd.eigenvectors() * diagonal;
+            result = scaledColumns(jd.eigenvectors(), diagonal, size);
             normalizePseudoRoot(matrix, result);
 
             if (negative)
@@ -404,11 +416,11 @@ namespace QuantLib {
             // negative eigenvalues set to zero
             negative=false;
             for (Size i=0; i<size; ++i){
-                diagonal[i][i] =
+                diagonal[i] =
                     std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
                 if (jd.eigenvalues()[i]<0.0) negative=true;
             }
-            result = jd.eigenvectors() * diagonal;
+            result = scaledColumns(jd.eigenvectors(), diagonal, size);
 
             normalizePseudoRoot(matrix, result);
 
@@ -502,10 +514,11 @@ namespace QuantLib {
         // output is granted to have a rank<=maxRank
         retainedFactors=std::min(retainedFactors, maxRank);
 
-        Matrix diagonal(size, retainedFactors, 0.0);
+        Array diagonal(retainedFactors);
         for (Size i=0; i<retainedFactors; ++i)
-            diagonal[i][i] = std::sqrt(eigenValues[i]);
-        Matrix result = jd.eigenvectors() * diagonal;
+            diagonal[i] = std::sqrt(eigenValues[i]);
+        Matrix result =
+            scaledColumns(jd.eigenvectors(), diagonal, retainedFactors);
 
         normalizePseudoRoot(matrix, result);
         return result;
@@ -19,16 +19,32 @@
 */
 
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/tqreigendecomposition.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace {
+
+        // below this size, Jacobi sweeps are competitive
+        const Size jacobiThreshold = 24;
+
+    }
+
     SymmetricSchurDecomposition::SymmetricSchurDecomposition(const Matrix & s)
     : diagonal_(s.rows()), eigenVectors_(s.rows(), s.columns(), 0.0) {
 
         QL_REQUIRE(s.rows() > 0 && s.columns() > 0, "null matrix given");
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
+        if (s.rows() > jacobiThreshold)
+            tridiagonalDecomposition_(s);
+        else
+            jacobiDecomposition_(s);
+    }
+
+    void SymmetricSchurDecomposition::jacobiDecomposition_(const Matrix& s) {
+
         Size size = s.rows();
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
@@ -138,4 +154,99 @@ namespace QuantLib {
         }
     }
 
+    void SymmetricSchurDecomposition::tridiagonalDecomposition_(
+                                                           const Matrix& s) {
+        const Size n = s.rows();
+        Matrix a = s;
+        Array d(n), e(n-1), beta(n, 0.0), p(n), w(n);
+
+        // Householder reduction to tridiagonal form (Golub and Van
+        // Loan, algorithm 8.3.1).  At step k, the reflection
+        // I - beta v v^T zeroes the elements below the subdiagonal in
+        // the k-th column; being the matrix symmetric, the column is
+        // read from the k-th row, which is then used to store v.
+        for (Size k=0; k<n; ++k) {
+            Matrix::row_iterator x = a.row_begin(k);
+            d[k] = x[k];
+            if (k+1 == n)
+                break;
+
+            Real sigma = 0.0;
+            for (Size i=k+2; i<n; ++i)
+                sigma += x[i]*x[i];
+            if (sigma == 0.0) {
+                // nothing to zero
+                e[k] = x[k+1];
+                continue;
+            }
+            const Real mu = std::sqrt(x[k+1]*x[k+1] + sigma);
+            const Real v1 = (x[k+1] <= 0.0) ? Real(x[k+1] - mu)
+                                            : Real(-sigma/(x[k+1] + mu));
+            beta[k] = 2.0*v1*v1/(sigma + v1*v1);
+            x[k+1] = 1.0;
+            for (Size i=k+2; i<n; ++i)
+                x[i] /= v1;
+            e[k] = mu;
+
+            // with p = beta A v and w = p - beta/2 (p.v) v, the
+            // trailing block becomes A - v w^T - w v^T
+            Real pv = 0.0;
+            for (Size i=k+1; i<n; ++i) {
+                Matrix::const_row_iterator ai = a.row_begin(i);
+                Real sum = 0.0;
+                for (Size j=k+1; j<n; ++j)
+                    sum += ai[j]*x[j];
+                p[i] = beta[k]*sum;
+                pv += p[i]*x[i];
+            }
+            for (Size i=k+1; i<n; ++i)
+                w[i] = p[i] - 0.5*beta[k]*pv*x[i];
+            for (Size i=k+1; i<n; ++i) {
+                Matrix::row_iterator ai = a.row_begin(i);
+                const Real vi = x[i], wi = w[i];
+                for (Size j=k+1; j<n; ++j)
+                    ai[j] -= vi*w[j] + wi*x[j];
+            }
+        }
+
+        // Q = H_0 H_1 ... H_{n-2}, accumulated starting from the last
+        // reflection so that each one only works on a trailing block
+        Matrix q(n, n, 0.0);
+        for (Size i=0; i<n; ++i)
+            q[i][i] = 1.0;
+        for (Size k=n-1; k-- > 0; ) {
+            if (beta[k] == 0.0)
+                continue;
+            Matrix::const_row_iterator v = a.row_begin(k);
+            std::fill(p.begin()+k+1, p.end(), 0.0);
+            for (Size i=k+1; i<n; ++i) {
+                Matrix::const_row_iterator qi = q.row_begin(i);
+                const Real vi = v[i];
+                for (Size j=k+1; j<n; ++j)
+                    p[j] += vi*qi[j];
+            }
+            for (Size i=k+1; i<n; ++i) {
+                Matrix::row_iterator qi = q.row_begin(i);
+                const Real bvi = beta[k]*v[i];
+                for (Size j=k+1; j<n; ++j)
+                    qi[j] -= bvi*p[j];
+            }
+        }
+
+        // The eigenvectors of Q T Q^T are Q times the ones of T.
+        // Being the first row of Q the unit vector, the sign of their
+        // first element is the one fixed by TqrEigenDecomposition.
+        TqrEigenDecomposition tqr(d, e);
+        eigenVectors_ = q * tqr.eigenvectors();
+
+        const Array& eigenvalues = tqr.eigenvalues();
+        Real maxEv = eigenvalues[0];
+        for (Size i=0; i<n; ++i) {
+            // check for round-off errors
+            diagonal_[i] =
+                (std::fabs(eigenvalues[i]/maxEv)<1e-16 ? 0.0 :
+                                                         eigenvalues[i]);
+        }
+    }
+
 }
@@ -44,6 +44,14 @@ namespace QuantLib {
         second edition, by Golub and Van Loan,
         The Johns Hopkins University Press
 
+        Matrices larger than a few tens of rows are instead reduced
+        to tridiagonal form by Householder reflections, after which
+        the eigensystem is found by TqrEigenDecomposition; this
+        requires \f$ O(n^3) \f$ operations with a much smaller
+        constant than the Jacobi sweeps.  Eigenvalues are returned
+        in decreasing order, and each eigenvector is normalized so
+        that its first element is positive, whatever the algorithm.
+
         \test the correctness of the returned values is tested by
               checking their properties.
     */
@@ -56,6 +64,8 @@ namespace QuantLib {
       private:
         Array diagonal_;
         Matrix eigenVectors_;
+        void jacobiDecomposition_(const Matrix& s);
+        void tridiagonalDecomposition_(const Matrix& s);
         void jacobiRotate_(Matrix & m, Real rot, Real dil,
                            Size j1, Size k1, Size j2, Size k2) const;
     };
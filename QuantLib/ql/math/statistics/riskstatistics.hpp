@@ -26,6 +26,7 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 
 namespace QuantLib {
 
@@ -123,6 +124,17 @@ namespace QuantLib {
     */
     typedef GenericRiskStatistics<GaussianStatistics> RiskStatistics;
 
+    //! risk measures tool with bounded memory
+    /*! The risk measures are estimated from the digest kept by
+        StreamingStatistics; see the latter for the error bounds.
+
+        \test the returned values are tested against the ones
+              returned by RiskStatistics on the same samples.
+    */
+    typedef GenericRiskStatistics<
+                    GenericGaussianStatistics<StreamingStatistics> >
+                                                   StreamingRiskStatistics;
+
 
 
     // inline definitions
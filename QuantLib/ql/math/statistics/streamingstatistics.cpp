@@ -0,0 +1,170 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    StreamingStatistics::StreamingStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression_ >= 10.0,
+                   "compression (" << compression_ << ") too small");
+        bufferSize_ = static_cast<Size>(5.0*compression_);
+        buffer_.reserve(bufferSize_);
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        IncrementalStatistics::add(value, weight);
+        // null weights don't change the distribution
+        if (weight == 0.0)
+            return;
+        Centroid c = { value, weight, 1 };
+        buffer_.push_back(c);
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        QL_REQUIRE(&other != this, "cannot merge statistics with itself");
+        if (other.sampleNumber_ == 0)
+            return;
+        if (sampleNumber_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+        }
+        sampleNumber_ += other.sampleNumber_;
+        downsideSampleNumber_ += other.downsideSampleNumber_;
+        sampleWeight_ += other.sampleWeight_;
+        downsideSampleWeight_ += other.downsideSampleWeight_;
+        sum_ += other.sum_;
+        quadraticSum_ += other.quadraticSum_;
+        downsideQuadraticSum_ += other.downsideQuadraticSum_;
+        cubicSum_ += other.cubicSum_;
+        fourthPowerSum_ += other.fourthPowerSum_;
+
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void StreamingStatistics::reset() {
+        IncrementalStatistics::reset();
+        centroids_.clear();
+        buffer_.clear();
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(), LessMean());
+
+        Real total = 0.0;
+        std::vector<Centroid>::const_iterator i;
+        for (i=buffer_.begin(); i!=buffer_.end(); ++i)
+            total += i->weight;
+
+        // Each centroid can grow until its right end reaches the
+        // quantile whose scale k(q) is one more than the one of its
+        // left end; k(q) = delta/(2 pi) asin(2q-1), so that the
+        // increment in q is smaller in the tails.
+        const Real c = 2.0*M_PI/compression_;
+        Real weightSoFar = 0.0;
+        Real theta = std::asin(-1.0) + c;
+        Real limit = total * 0.5*(1.0 + std::sin(std::min(theta, M_PI_2)));
+
+        centroids_.clear();
+        Centroid current = buffer_.front();
+        for (i=buffer_.begin()+1; i!=buffer_.end(); ++i) {
+            if (weightSoFar + current.weight + i->weight <= limit) {
+                current.weight += i->weight;
+                current.mean += (i->mean - current.mean)
+                              * i->weight / current.weight;
+                current.samples += i->samples;
+            } else {
+                weightSoFar += current.weight;
+                centroids_.push_back(current);
+                current = *i;
+                Real q = std::min(weightSoFar/total, 1.0);
+                theta = std::asin(2.0*q - 1.0) + c;
+                limit = total * 0.5*(1.0 + std::sin(std::min(theta, M_PI_2)));
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    Real StreamingStatistics::quantile(Real q) const {
+        compress();
+        QL_REQUIRE(!centroids_.empty(), "empty sample set");
+
+        Real total = 0.0;
+        std::vector<Centroid>::const_iterator i;
+        for (i=centroids_.begin(); i!=centroids_.end(); ++i)
+            total += i->weight;
+        Real target = q*total;
+
+        // Each centroid is taken to have half its weight on each side
+        // of its mean; the ends of the distribution are interpolated
+        // towards the exact minimum and maximum.
+        const Centroid& first = centroids_.front();
+        Real cumulated = 0.5*first.weight;
+        if (target < cumulated) {
+            if (first.samples == 1)
+                return first.mean;
+            return min_ + (first.mean - min_)*target/cumulated;
+        }
+
+        for (i=centroids_.begin(); i+1!=centroids_.end(); ++i) {
+            const Centroid& left = *i;
+            const Centroid& right = *(i+1);
+            Real step = 0.5*(left.weight + right.weight);
+            if (target < cumulated + step)
+                return left.mean + (right.mean - left.mean)
+                                 * (target - cumulated)/step;
+            cumulated += step;
+        }
+
+        const Centroid& last = centroids_.back();
+        if (last.samples == 1)
+            return last.mean;
+        Real fraction = std::min((target - cumulated)/(0.5*last.weight), 1.0);
+        return last.mean + (max_ - last.mean)*fraction;
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        return quantile(percent);
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        return quantile(1.0 - percent);
+    }
+
+}
@@ -0,0 +1,185 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with bounded-memory quantile estimation
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded-memory quantile estimation
+    /*! This class accumulates moments as IncrementalStatistics does
+        and, besides, keeps a t-digest of the data (see Dunning and
+        Ertl, "Computing extremely accurate quantiles using
+        t-digests", 2019) so that percentiles and the risk measures
+        of GenericRiskStatistics can be estimated without storing
+        the samples.  Its memory footprint depends on the compression
+        \f$ \delta \f$ but not on the number of samples.
+
+        The digest is a sorted set of centroids, each one summarizing
+        the samples in a contiguous range of the distribution by
+        their mean and weight.  Using the scale function
+        \f[ k(q) = \frac{\delta}{2\pi} \arcsin(2q-1), \f]
+        a centroid spanning the quantiles between \f$ q_1 \f$ and
+        \f$ q_2 \f$ is only formed if \f$ k(q_2) - k(q_1) \leq 1 \f$;
+        therefore, there are at most \f$ \delta \f$ centroids and the
+        ones around the quantile \f$ q \f$ span at most
+        \f$ 2\pi\sqrt{q(1-q)}/\delta \f$ of the total weight.  This
+        is a bound on the error on the rank of the value returned by
+        percentile(); in practice, the interpolation between
+        centroids makes the actual error much smaller.  Minimum and
+        maximum are exact, and the centroids become single samples
+        as the weight of the tails goes to zero.
+
+        The expectationValue() method (on which the risk measures
+        are based) treats each centroid as a single sample placed at
+        its mean; therefore, the range is resolved up to the size of
+        the centroids at its boundaries.
+
+        Two instances can be merged, e.g., after accumulating
+        samples in separate threads; the bounds above still hold
+        for the merged digest.
+
+        \warning as for IncrementalStatistics, high moments are
+                 numerically unstable for high
+                 average/standardDeviation ratios.
+    */
+    class StreamingStatistics : public IncrementalStatistics {
+      public:
+        typedef Real value_type;
+        explicit StreamingStatistics(Real compression = 200.0);
+        //! \name Inspectors
+        //@{
+        //! the compression \f$ \delta \f$ of the digest
+        Real compression() const;
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, i.e.,
+            \f[ \mathrm{E}\left[f \;|\; \mathcal{R}\right] =
+                \frac{\sum_{c_i \in \mathcal{R}} f(c_i) w_i}{
+                      \sum_{c_i \in \mathcal{R}} w_i}, \f]
+            where the \f$ c_i \f$ are the centroids of the digest
+            and the \f$ w_i \f$ their weights.  The range is passed
+            as a boolean function returning <tt>true</tt> if the
+            argument belongs to the range or <tt>false</tt> otherwise.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            std::vector<Centroid>::const_iterator i;
+            for (i=centroids_.begin(); i!=centroids_.end(); ++i) {
+                Real x = i->mean, w = i->weight;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += i->samples;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! \f$ y \f$-th percentile, defined as the value \f$ \bar{x} \f$
+            such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+            and estimated by interpolating linearly between the
+            centroids of the digest.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! \f$ y \f$-th top percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+            and estimated as above.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        void merge(const StreamingStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size samples;
+        };
+        struct LessMean {
+            bool operator()(const Centroid& c1, const Centroid& c2) const {
+                return c1.mean < c2.mean;
+            }
+        };
+        void compress() const;
+        Real quantile(Real q) const;
+
+        Real compression_;
+        Size bufferSize_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+
+    // inline definitions
+
+    inline Real StreamingStatistics::compression() const {
+        return compression_;
+    }
+
+}
+
+
+#endif
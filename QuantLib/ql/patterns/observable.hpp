@@ -31,7 +31,8 @@
 
 #include <boost/shared_ptr.hpp>
 
-#include <set>
+#include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -43,7 +44,7 @@ namespace QuantLib {
         friend class Observer;
       public:
         // constructors, assignment, destructor
-        Observable() {}
+        Observable() : notifying_(0), removed_(false) {}
         Observable(const Observable&);
         Observable& operator=(const Observable&);
         virtual ~Observable() {}
@@ -52,23 +53,46 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        typedef std::set<Observer*>::iterator iterator;
-        std::pair<iterator, bool> registerObserver(Observer*);
-        Size unregisterObserver(Observer*);
-        std::set<Observer*> observers_;
+        Size registerObserver(Observer*);
+        void unregisterObserver(Size position);
+        void compact();
+        /* Observers are kept in no particular order; the one being
+           unregistered is replaced by the last one, which is told
+           its new position.  Both operations are constant-time.
+           While notifications are being sent, the list can't be
+           rearranged: unregistered observers are cleared instead,
+           and the list is compacted when the notification is over.
+        */
+        std::vector<Observer*> observers_;
+        // depth of the notifications in progress
+        Size notifying_;
+        // whether observers were cleared during them
+        bool removed_;
     };
 
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer {
+        friend class Observable;
+      private:
+        struct Registration {
+            boost::shared_ptr<Observable> observable;
+            // position of this instance among its observers
+            Size position;
+        };
+        typedef std::vector<Registration> registration_list;
       public:
+        typedef registration_list::iterator iterator;
         // constructors, assignment, destructor
         Observer() {}
         Observer(const Observer&);
         Observer& operator=(const Observer&);
         virtual ~Observer();
         // observer interface
-        std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
+        /*! The observables are looked up by binary search; the
+            returned iterator is invalidated by further registrations.
+        */
+        std::pair<iterator, bool>
                             registerWith(const boost::shared_ptr<Observable>&);
         Size unregisterWith(const boost::shared_ptr<Observable>&);
         /*! This method must be implemented in derived classes. An
@@ -79,14 +103,23 @@ namespace QuantLib {
         void unregisterWithAll();
         virtual void update() = 0;
       private:
-        std::set<boost::shared_ptr<Observable> > observables_;
-        typedef std::set<boost::shared_ptr<Observable> >::iterator iterator;
+        void registerWithAll();
+        void moved(const Observable*, Size position);
+        iterator find(const Observable*);
+        static bool precedes(const Registration&, const Observable*);
+        /* Registrations are sorted by the address of the observable.
+           An instance usually registers with a few observables, so
+           that a contiguous list is searched faster than a tree and
+           its insertions and removals only move a few elements.
+        */
+        registration_list observables_;
     };
 
 
     // inline definitions
 
-    inline Observable::Observable(const Observable&) {
+    inline Observable::Observable(const Observable&)
+    : notifying_(0), removed_(false) {
         // the observer set is not copied; no observer asked to
         // register with this object
     }
@@ -107,21 +140,60 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<std::set<Observer*>::iterator, bool>
-    Observable::registerObserver(Observer* o) {
-        return observers_.insert(o);
+    inline Size Observable::registerObserver(Observer* o) {
+        observers_.push_back(o);
+        return observers_.size()-1;
     }
 
-    inline Size Observable::unregisterObserver(Observer* o) {
-        return observers_.erase(o);
+    inline void Observable::unregisterObserver(Size position) {
+        if (notifying_ > 0) {
+            observers_[position] = 0;
+            removed_ = true;
+            return;
+        }
+        Observer* last = observers_.back();
+        observers_.pop_back();
+        if (position < observers_.size()) {
+            observers_[position] = last;
+            last->moved(this, position);
+        }
+        // give back the memory of lists which shrank a lot
+        if (observers_.capacity() > 64 &&
+            observers_.size() < observers_.capacity()/4)
+            std::vector<Observer*>(observers_).swap(observers_);
+    }
+
+    inline void Observable::compact() {
+        Size n = 0;
+        for (Size i=0; i<observers_.size(); ++i) {
+            if (observers_[i]) {
+                if (i != n) {
+                    observers_[n] = observers_[i];
+                    observers_[n]->moved(this, n);
+                }
+                ++n;
+            }
+        }
+        observers_.resize(n);
+        removed_ = false;
+        // give back the memory of lists which shrank a lot
+        if (observers_.capacity() > 64 &&
+            observers_.size() < observers_.capacity()/4)
+            std::vector<Observer*>(observers_).swap(observers_);
     }
 
     inline void Observable::notifyObservers() {
         bool successful = true;
         std::string errMsg;
-        for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+        ++notifying_;
+        // by index, since observers might register while notified;
+        // the ones unregistered in the meantime are cleared.
+        for (Size i=0; i<observers_.size(); ++i) {
+            Observer* observer = observers_[i];
+            if (!observer)
+                continue;
             try {
-                (*i)->update();
+                observer->update();
             } catch (std::exception& e) {
                 // quite a dilemma. If we don't catch the exception,
                 // other observers will not receive the notification
@@ -136,6 +208,8 @@ namespace QuantLib {
                 successful = false;
             }
         }
+        if (--notifying_ == 0 && removed_)
+            compact();
         QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
     }
@@ -143,47 +217,78 @@ namespace QuantLib {
 
     inline Observer::Observer(const Observer& o)
     : observables_(o.observables_) {
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->registerObserver(this);
+        registerWithAll();
     }
 
     inline Observer& Observer::operator=(const Observer& o) {
-        iterator i;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(this);
-        observables_ = o.observables_;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->registerObserver(this);
+        if (&o != this) {
+            unregisterWithAll();
+            observables_ = o.observables_;
+            registerWithAll();
+        }
         return *this;
     }
 
     inline Observer::~Observer() {
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(this);
+        unregisterWithAll();
     }
 
-    inline std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
+    inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const boost::shared_ptr<Observable>& h) {
         if (h) {
-            h->registerObserver(this);
-            return observables_.insert(h);
+            iterator i = std::lower_bound(observables_.begin(),
+                                          observables_.end(),
+                                          h.get(), precedes);
+            if (i != observables_.end() && i->observable == h)
+                return std::make_pair(i, false);
+            i = observables_.insert(i, Registration());
+            i->observable = h;
+            i->position = h->registerObserver(this);
+            return std::make_pair(i, true);
         }
         return std::make_pair(observables_.end(), false);
     }
 
     inline
     Size Observer::unregisterWith(const boost::shared_ptr<Observable>& h) {
-        if (h)
-            h->unregisterObserver(this);
-        return observables_.erase(h);
+        iterator i = find(h.get());
+        if (i == observables_.end())
+            return 0;
+        h->unregisterObserver(i->position);
+        observables_.erase(i);
+        return 1;
     }
 
     inline void Observer::unregisterWithAll() {
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(this);
+            i->observable->unregisterObserver(i->position);
         observables_.clear();
     }
 
+    inline void Observer::registerWithAll() {
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+            i->position = i->observable->registerObserver(this);
+    }
+
+    inline void Observer::moved(const Observable* h, Size position) {
+        iterator i = find(h);
+        if (i != observables_.end())
+            i->position = position;
+    }
+
+    inline Observer::iterator Observer::find(const Observable* h) {
+        iterator i = std::lower_bound(observables_.begin(),
+                                      observables_.end(), h, precedes);
+        if (i != observables_.end() && i->observable.get() == h)
+            return i;
+        return observables_.end();
+    }
+
+    inline bool Observer::precedes(const Registration& r,
+                                   const Observable* h) {
+        return r.observable.get() < h;
+    }
+
 }
 
 #endif
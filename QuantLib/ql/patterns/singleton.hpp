@@ -29,6 +29,14 @@
 #include <boost/noncopyable.hpp>
 #include <map>
 
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    #if defined(QL_ENABLE_SESSIONS)
+        #error QL_ENABLE_SESSIONS and QL_ENABLE_THREAD_LOCAL_SESSIONS \
+               cannot be both defined
+    #endif
+    #include <boost/thread/tss.hpp>
+#endif
+
 namespace QuantLib {
 
     #if defined(QL_ENABLE_SESSIONS)
@@ -60,6 +68,14 @@ namespace QuantLib {
         as a single implemementation point should synchronization
         features be added.
 
+        If QL_ENABLE_SESSIONS is defined, a different instance is
+        returned for each session id returned by the user-provided
+        sessionId() function.  If QL_ENABLE_THREAD_LOCAL_SESSIONS is
+        defined instead, each thread is a session: the instance is
+        created the first time it's accessed from a given thread and
+        destroyed when the thread exits.  In both cases, objects
+        created in a session should not be used from another.
+
         \ingroup patterns
     */
     template <class T>
@@ -75,6 +91,12 @@ namespace QuantLib {
 
     template <class T>
     T& Singleton<T>::instance() {
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        static boost::thread_specific_ptr<T> instance_;
+        if (!instance_.get())
+            instance_.reset(new T);
+        return *instance_;
+        #else
         static std::map<Integer, boost::shared_ptr<T> > instances_;
         #if defined(QL_ENABLE_SESSIONS)
         Integer id = sessionId();
@@ -85,6 +107,7 @@ namespace QuantLib {
         if (!instance)
             instance = boost::shared_ptr<T>(new T);
         return *instance;
+        #endif
     }
 
     // reverts the change above
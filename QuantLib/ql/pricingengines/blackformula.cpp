@@ -265,6 +265,190 @@ namespace QuantLib {
             forward, blackPrice, discount, displacement, guess, accuracy, maxIterations);
     }
 
+
+    namespace {
+
+        void checkSizes(const std::vector<Option::Type>& optionTypes,
+                        const Array& strikes,
+                        const Array& forwards,
+                        const Array& values,
+                        const Array& discounts) {
+            Size n = optionTypes.size();
+            QL_REQUIRE(strikes.size() == n,
+                       "wrong number of strikes (" << strikes.size()
+                       << ", " << n << " required)");
+            QL_REQUIRE(forwards.size() == n,
+                       "wrong number of forwards (" << forwards.size()
+                       << ", " << n << " required)");
+            QL_REQUIRE(values.size() == n,
+                       "wrong number of values (" << values.size()
+                       << ", " << n << " required)");
+            QL_REQUIRE(discounts.size() == n,
+                       "wrong number of discounts (" << discounts.size()
+                       << ", " << n << " required)");
+        }
+
+        /* Solves for the standard deviation giving the undiscounted
+           price p to an out-of-the-money option (or an at-the-money
+           one) on the displaced strike and forward.  The objective is
+           either b(s)-p or, below the inflection point of b (where b
+           is convex and possibly tiny) log(b(s)/p), which is closer
+           to linear; each Halley step is kept within the bracket
+           found so far, and replaced by bisection if it falls out. */
+        Real solveImpliedStdDev(Option::Type optionType,
+                                Real strike,
+                                Real forward,
+                                Real price,
+                                Real accuracy,
+                                Natural maxIterations,
+                                const CumulativeNormalDistribution& N) {
+            if (price == 0.0)
+                return 0.0;
+            Real upperBound = (optionType == Option::Call ? forward : strike);
+            QL_REQUIRE(price < upperBound,
+                       "undiscounted " << optionType << " price (" << price
+                       << ") not below its upper bound (" << upperBound
+                       << "). No solution exists for strike " << strike
+                       << ", forward " << forward);
+
+            Real x = std::log(forward/strike);
+            Real inflection = std::sqrt(2.0*std::fabs(x));
+            Real lower = 0.0, upper = QL_MAX_REAL;
+
+            Real stdDev = blackFormulaImpliedStdDevApproximation(
+                                 optionType, strike, forward, price);
+            if (stdDev <= 0.0)
+                stdDev = (inflection > 0.0 ? inflection : 1.0);
+
+            for (Natural i=0; i<maxIterations; ++i) {
+                Real d1 = x/stdDev + 0.5*stdDev, d2 = d1 - stdDev;
+                Real b = optionType*(forward*N(optionType*d1)
+                                     - strike*N(optionType*d2));
+                if (b > price)
+                    upper = stdDev;
+                else
+                    lower = stdDev;
+
+                // derivatives of b with respect to the standard deviation
+                Real b1 = forward*N.derivative(d1);
+                Real b2 = b1*d1*d2/stdDev;
+
+                Real step = Null<Real>();
+                if (stdDev < inflection && b > 0.0) {
+                    Real g = std::log(b/price), g1 = b1/b, g2 = b2/b - g1*g1;
+                    Real newton = -g/g1;
+                    step = newton/(1.0 + 0.5*newton*g2/g1);
+                } else if (b1 > 0.0) {
+                    Real newton = -(b-price)/b1;
+                    step = newton/(1.0 + 0.5*newton*b2/b1);
+                }
+
+                if (step != Null<Real>() && std::fabs(step) < accuracy)
+                    return stdDev + step;
+
+                Real next = (step != Null<Real>() ? stdDev + step : lower);
+                if (!(next > lower && next < upper))
+                    next = (upper == QL_MAX_REAL ? 2.0*stdDev
+                                                 : 0.5*(lower+upper));
+                if (std::fabs(next-stdDev) < accuracy)
+                    return next;
+                stdDev = next;
+            }
+            QL_FAIL("maximum number of iterations (" << maxIterations
+                    << ") exceeded for " << optionType << " strike "
+                    << strike << ", forward " << forward
+                    << ", undiscounted price " << price);
+        }
+
+    }
+
+
+    Disposable<Array> blackFormula(
+                            const std::vector<Option::Type>& optionTypes,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& stdDevs,
+                            const Array& discounts,
+                            Real displacement) {
+        checkSizes(optionTypes, strikes, forwards, stdDevs, discounts);
+        Array results(optionTypes.size());
+        for (Size i=0; i<results.size(); ++i)
+            results[i] = blackFormula(optionTypes[i], strikes[i],
+                                      forwards[i], stdDevs[i],
+                                      discounts[i], displacement);
+        return results;
+    }
+
+    Disposable<Array> blackFormulaImpliedStdDevApproximation(
+                            const std::vector<Option::Type>& optionTypes,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& blackPrices,
+                            const Array& discounts,
+                            Real displacement) {
+        checkSizes(optionTypes, strikes, forwards, blackPrices, discounts);
+        Array results(optionTypes.size());
+        for (Size i=0; i<results.size(); ++i)
+            results[i] = blackFormulaImpliedStdDevApproximation(
+                                   optionTypes[i], strikes[i], forwards[i],
+                                   blackPrices[i], discounts[i],
+                                   displacement);
+        return results;
+    }
+
+    Disposable<Array> blackFormulaImpliedStdDev(
+                            const std::vector<Option::Type>& optionTypes,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& blackPrices,
+                            const Array& discounts,
+                            Real displacement,
+                            Real accuracy,
+                            Natural maxIterations) {
+        checkSizes(optionTypes, strikes, forwards, blackPrices, discounts);
+        CumulativeNormalDistribution N;
+        Array results(optionTypes.size());
+        for (Size i=0; i<results.size(); ++i) {
+            Option::Type optionType = optionTypes[i];
+            Real strike = strikes[i], forward = forwards[i];
+            Real blackPrice = blackPrices[i], discount = discounts[i];
+
+            checkParameters(strike, forward, displacement);
+            QL_REQUIRE(discount>0.0,
+                       "discount (" << discount << ") must be positive");
+            QL_REQUIRE(blackPrice>=0.0,
+                       "option price (" << blackPrice <<
+                       ") must be non-negative");
+            Real otherOptionPrice =
+                blackPrice - optionType*(forward-strike)*discount;
+            QL_REQUIRE(otherOptionPrice>=0.0,
+                       "negative " << Option::Type(-1*optionType) <<
+                       " price (" << otherOptionPrice <<
+                       ") implied by put-call parity. No solution exists for " <<
+                       optionType << " strike " << strike <<
+                       ", forward " << forward <<
+                       ", price " << blackPrice <<
+                       ", deflator " << discount);
+
+            // as above, solve for the out-of-the-money option
+            if (optionType==Option::Put && strike>forward) {
+                optionType = Option::Call;
+                blackPrice = otherOptionPrice;
+            }
+            if (optionType==Option::Call && strike<forward) {
+                optionType = Option::Put;
+                blackPrice = otherOptionPrice;
+            }
+
+            results[i] = solveImpliedStdDev(optionType,
+                                            strike + displacement,
+                                            forward + displacement,
+                                            blackPrice/discount,
+                                            accuracy, maxIterations, N);
+        }
+        return results;
+    }
+
     Real blackFormulaCashItmProbability(Option::Type optionType,
                                         Real strike,
                                         Real forward,
@@ -31,6 +31,8 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <ql/math/array.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -112,6 +114,57 @@ namespace QuantLib {
                         Natural maxIterations = 100);
 
 
+    /*! Black 1976 formula for a batch of options, e.g., an option
+        chain; the i-th result is the value of the option of type
+        optionTypes[i] on strikes[i], forwards[i], stdDevs[i] and
+        discounts[i].
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    Disposable<Array> blackFormula(
+                            const std::vector<Option::Type>& optionTypes,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& stdDevs,
+                            const Array& discounts,
+                            Real displacement = 0.0);
+
+    /*! Approximated Black 1976 implied standard deviations for a
+        batch of options; see the single-option version.
+    */
+    Disposable<Array> blackFormulaImpliedStdDevApproximation(
+                            const std::vector<Option::Type>& optionTypes,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& blackPrices,
+                            const Array& discounts,
+                            Real displacement = 0.0);
+
+    /*! Black 1976 implied standard deviations for a batch of options.
+
+        Each option is solved independently with the same checks as
+        the single-option version, and the results agree with it
+        within the given accuracy.  However, no solver object is
+        built; instead, starting from the Corrado-Miller guess, a
+        bracketed Halley iteration is run on the price or, below
+        the inflection point of the Black formula in the standard
+        deviation (where the price is convex and can be very small),
+        on its logarithm, as suggested by Jaeckel ("Let's be
+        rational", 2015.)  This usually converges in two or three
+        iterations.
+    */
+    Disposable<Array> blackFormulaImpliedStdDev(
+                            const std::vector<Option::Type>& optionTypes,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& blackPrices,
+                            const Array& discounts,
+                            Real displacement = 0.0,
+                            Real accuracy = 1.0e-6,
+                            Natural maxIterations = 100);
+
+
     /*! Black 1976 probability of being in the money (in the bond martingale
         measure), i.e. N(d2).
         It is a risk-neutral probability, not the real world one.
@@ -26,6 +26,11 @@
 #include <ql/pricingengines/bond/bondfunctions.hpp>
 #include <ql/instruments/bond.hpp>
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
 
 using boost::shared_ptr;
 
@@ -519,4 +524,472 @@ namespace QuantLib {
                                   accuracy, maxIterations, guess);
     }
 
+    namespace {
+
+        // as in InterestRate::compoundFactor
+        inline Real compoundFactor(Rate r, Time t,
+                                   Compounding comp, Real freq) {
+            switch (comp) {
+              case Simple:
+                return 1.0 + r*t;
+              case Compounded:
+                return std::pow(1.0+r/freq, freq*t);
+              case Continuous:
+                return std::exp(r*t);
+              case SimpleThenCompounded:
+                if (t<=1.0/freq)
+                    return 1.0 + r*t;
+                else
+                    return std::pow(1.0+r/freq, freq*t);
+              default:
+                QL_FAIL("unknown compounding convention");
+            }
+        }
+
+        // derivative of the log of the above with respect to r
+        inline Real compoundFactorLogDerivative(Rate r, Time t,
+                                                Compounding comp,
+                                                Real freq) {
+            switch (comp) {
+              case Simple:
+                return t/(1.0 + r*t);
+              case Compounded:
+                return t/(1.0 + r/freq);
+              case Continuous:
+                return t;
+              case SimpleThenCompounded:
+                if (t<=1.0/freq)
+                    return t/(1.0 + r*t);
+                else
+                    return t/(1.0 + r/freq);
+              default:
+                QL_FAIL("unknown compounding convention");
+            }
+        }
+
+        // lowest rate giving a positive compound factor at time t
+        Rate lowestRate(Time t, Compounding comp, Real freq) {
+            switch (comp) {
+              case Simple:
+                return t > 0.0 ? Rate(-1.0/t) : Rate(-QL_MAX_REAL);
+              case Compounded:
+                return -freq;
+              case Continuous:
+                return -QL_MAX_REAL;
+              case SimpleThenCompounded:
+                if (t<=1.0/freq)
+                    return t > 0.0 ? Rate(-1.0/t) : Rate(-QL_MAX_REAL);
+                else
+                    return -freq;
+              default:
+                QL_FAIL("unknown compounding convention");
+            }
+        }
+
+        // the remaining cash flows of a set of bonds, stored
+        // contiguously; the flows of the j-th bond are the ones
+        // between begin[j] and begin[j+1].
+        struct FlattenedBonds {
+            std::vector<Size> begin;
+            std::vector<Real> amounts;
+            // between the previous flow (or the settlement) and the
+            // flow, as used by CashFlows::npv for the yield
+            std::vector<Time> periods;
+            // between the settlement and the flow, as used by
+            // CashFlows::duration and CashFlows::convexity
+            std::vector<Time> times;
+            // on the discount curve, for the z-spread
+            std::vector<Time> curveTimes;
+            std::vector<Rate> zeroRates;
+            // per bond
+            std::vector<Real> targets;
+            std::vector<Rate> lowestYields;
+            std::vector<Time> settlementTimes;
+            std::vector<Rate> settlementZeroRates;
+            std::vector<Spread> lowestSpreads;
+        };
+
+        class YieldObjective {
+          public:
+            YieldObjective(const FlattenedBonds& bonds,
+                           Compounding comp, Real freq)
+            : bonds_(bonds), comp_(comp), freq_(freq) {}
+            // the price at the given yield as in CashFlows::npv, and
+            // its derivative
+            void price(Size j, Rate y, Real& P, Real& dPdy) const {
+                const std::vector<Real>& c = bonds_.amounts;
+                const std::vector<Time>& tau = bonds_.periods;
+                DiscountFactor discount = 1.0;
+                Real dLogDiscount = 0.0;
+                P = dPdy = 0.0;
+                for (Size k=bonds_.begin[j]; k<bonds_.begin[j+1]; ++k) {
+                    discount /= compoundFactor(y, tau[k], comp_, freq_);
+                    dLogDiscount -=
+                        compoundFactorLogDerivative(y, tau[k], comp_, freq_);
+                    P += c[k] * discount;
+                    dPdy += c[k] * discount * dLogDiscount;
+                }
+            }
+            void operator()(Size j, Rate y, Real& f, Real& df) const {
+                price(j, y, f, df);
+                f -= bonds_.targets[j];
+            }
+          private:
+            const FlattenedBonds& bonds_;
+            Compounding comp_;
+            Real freq_;
+        };
+
+        class ZSpreadObjective {
+          public:
+            ZSpreadObjective(const FlattenedBonds& bonds,
+                             Compounding comp, Real freq)
+            : bonds_(bonds), comp_(comp), freq_(freq) {}
+            // the price as in CashFlows::npv on a ZeroSpreadedTermStructure
+            void operator()(Size j, Spread s, Real& f, Real& df) const {
+                const std::vector<Real>& c = bonds_.amounts;
+                const std::vector<Time>& t = bonds_.curveTimes;
+                const std::vector<Rate>& r = bonds_.zeroRates;
+                Real N = 0.0, dNds = 0.0;
+                for (Size k=bonds_.begin[j]; k<bonds_.begin[j+1]; ++k) {
+                    DiscountFactor D =
+                        1.0/compoundFactor(r[k]+s, t[k], comp_, freq_);
+                    N += c[k] * D;
+                    dNds -= c[k] * D *
+                        compoundFactorLogDerivative(r[k]+s, t[k],
+                                                    comp_, freq_);
+                }
+                Time t0 = bonds_.settlementTimes[j];
+                Rate r0 = bonds_.settlementZeroRates[j];
+                DiscountFactor D0 = 1.0/compoundFactor(r0+s, t0, comp_, freq_);
+                Real g0 = compoundFactorLogDerivative(r0+s, t0, comp_, freq_);
+                f = N/D0 - bonds_.targets[j];
+                df = dNds/D0 + N*g0/D0;
+            }
+          private:
+            const FlattenedBonds& bonds_;
+            Compounding comp_;
+            Real freq_;
+        };
+
+        // Newton iterations, falling back to bisection once the root
+        // is bracketed and kept above the given lower bounds.  The
+        // iterations for the different bonds are run in lockstep.
+        // Bonds with an error are skipped; the ones for which no
+        // solution is found get a null result and an error.
+        template <class F>
+        void solve(const F& f, std::vector<Real>& x,
+                   const std::vector<Real>& lowerBounds,
+                   Real accuracy, Size maxIterations,
+                   const std::string& what,
+                   std::vector<std::string>& errors) {
+            Size n = x.size();
+            std::vector<Real> xNeg(n, Null<Real>()), xPos(n, Null<Real>());
+            std::vector<Size> active;
+            active.reserve(n);
+            for (Size j=0; j<n; ++j) {
+                if (!errors[j].empty()) {
+                    x[j] = Null<Real>();
+                } else if (!(x[j] > lowerBounds[j])) {
+                    std::ostringstream msg;
+                    msg << what << " guess (" << x[j] << ") out of range";
+                    errors[j] = msg.str();
+                    x[j] = Null<Real>();
+                } else {
+                    active.push_back(j);
+                }
+            }
+
+            for (Size iteration=0; !active.empty(); ++iteration) {
+                if (iteration >= maxIterations) {
+                    std::ostringstream msg;
+                    msg << "maximum number of function evaluations ("
+                        << maxIterations << ") exceeded while solving for "
+                        << what;
+                    for (Size i=0; i<active.size(); ++i) {
+                        errors[active[i]] = msg.str();
+                        x[active[i]] = Null<Real>();
+                    }
+                    break;
+                }
+                Size stillActive = 0;
+                for (Size i=0; i<active.size(); ++i) {
+                    Size j = active[i];
+                    Real fx, dfx;
+                    f(j, x[j], fx, dfx);
+                    if (fx == 0.0)
+                        continue;
+                    if (fx < 0.0)
+                        xNeg[j] = x[j];
+                    else
+                        xPos[j] = x[j];
+
+                    Real next = dfx != 0.0 ? Real(x[j] - fx/dfx)
+                                           : Null<Real>();
+                    if (xNeg[j] != Null<Real>() && xPos[j] != Null<Real>()) {
+                        Real xLow = std::min(xNeg[j], xPos[j]),
+                             xHigh = std::max(xNeg[j], xPos[j]);
+                        if (next == Null<Real>()
+                            || !(next > xLow && next < xHigh))
+                            next = 0.5*(xLow + xHigh);
+                    } else {
+                        if (next == Null<Real>()) {
+                            errors[j] = "null derivative while solving for "
+                                      + what;
+                            x[j] = Null<Real>();
+                            continue;
+                        }
+                        if (next <= lowerBounds[j])
+                            next = 0.5*(x[j] + lowerBounds[j]);
+                    }
+
+                    Real dx = next - x[j];
+                    x[j] = next;
+                    if (std::fabs(dx) >= accuracy)
+                        active[stillActive++] = j;
+                }
+                active.resize(stillActive);
+            }
+        }
+
+        Integer sign(Real x) {
+            if (x == 0.0)
+                return 0;
+            else if (x > 0.0)
+                return 1;
+            else
+                return -1;
+        }
+
+    }
+
+    std::vector<BondFunctions::Analytics> BondFunctions::analytics(
+                                const std::vector<shared_ptr<Bond> >& bonds,
+                                const std::vector<Real>& cleanPrices,
+                                const DayCounter& dayCounter,
+                                Compounding compounding,
+                                Frequency frequency,
+                                const shared_ptr<YieldTermStructure>& d,
+                                Duration::Type type,
+                                Date settlementDate,
+                                Real accuracy,
+                                Size maxIterations,
+                                Rate guess) {
+        QL_REQUIRE(bonds.size() == cleanPrices.size(),
+                   "mismatch between number of bonds (" << bonds.size()
+                   << ") and of prices (" << cleanPrices.size() << ")");
+        QL_REQUIRE(type != Duration::Macaulay || compounding == Compounded,
+                   "compounded rate required");
+        // checks the conventions
+        InterestRate conventions(guess, dayCounter, compounding, frequency);
+        Real freq = Real(conventions.frequency());
+
+        Size n = bonds.size();
+        FlattenedBonds flows;
+        flows.begin.reserve(n+1);
+        flows.targets.resize(n);
+        flows.lowestYields.resize(n, -QL_MAX_REAL);
+        if (d) {
+            flows.settlementTimes.resize(n);
+            flows.settlementZeroRates.resize(n);
+            flows.lowestSpreads.resize(n, -QL_MAX_REAL);
+        }
+
+        // a failure for a bond doesn't prevent the calculation of
+        // the others; its results are null and its error is stored
+        std::vector<std::string> errors(n);
+        for (Size j=0; j<n; ++j) {
+            flows.begin.push_back(flows.amounts.size());
+            try {
+                QL_REQUIRE(bonds[j], "null bond");
+                const Bond& bond = *bonds[j];
+                Date settlement = settlementDate;
+                if (settlement == Date())
+                    settlement = bond.settlementDate();
+
+                QL_REQUIRE(BondFunctions::isTradable(bond, settlement),
+                           "non tradable at " << settlement <<
+                           " (maturity being " << bond.maturityDate() << ")");
+
+                Real dirtyPrice =
+                    cleanPrices[j] + bond.accruedAmount(settlement);
+                dirtyPrice /= 100.0 / bond.notional(settlement);
+                flows.targets[j] = dirtyPrice;
+
+                // the curve is extrapolated as in the spreaded curve
+                // used by zSpread()
+                if (d) {
+                    Time t0 = d->timeFromReference(settlement);
+                    Rate r0 = d->zeroRate(t0, compounding, frequency,
+                                          true).rate();
+                    flows.settlementTimes[j] = t0;
+                    flows.settlementZeroRates[j] = r0;
+                    flows.lowestSpreads[j] =
+                        lowestRate(t0, compounding, freq) - r0;
+                }
+
+                const Leg& leg = bond.cashflows();
+                Date lastDate = settlement;
+                Date refStartDate, refEndDate;
+                Integer lastSign = sign(-dirtyPrice), signChanges = 0;
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (leg[i]->hasOccurred(settlement, false))
+                        continue;
+
+                    Date couponDate = leg[i]->date();
+                    Real amount = leg[i]->amount();
+                    shared_ptr<Coupon> coupon =
+                        boost::dynamic_pointer_cast<Coupon>(leg[i]);
+                    if (coupon) {
+                        refStartDate = coupon->accrualStartDate();
+                        refEndDate = coupon->accrualEndDate();
+                    } else {
+                        if (lastDate == settlement) {
+                            // we don't have a previous coupon date,
+                            // so we fake it
+                            refStartDate = couponDate - 1*Years;
+                        } else  {
+                            refStartDate = lastDate;
+                        }
+                        refEndDate = couponDate;
+                    }
+                    QL_REQUIRE(couponDate >= lastDate,
+                               "cash flow at " << couponDate
+                               << " follows one at " << lastDate);
+                    Time period = dayCounter.yearFraction(lastDate, couponDate,
+                                                          refStartDate,
+                                                          refEndDate);
+                    lastDate = couponDate;
+
+                    flows.amounts.push_back(amount);
+                    flows.periods.push_back(period);
+                    flows.times.push_back(
+                              dayCounter.yearFraction(settlement, couponDate));
+                    flows.lowestYields[j] =
+                        std::max(flows.lowestYields[j],
+                                 lowestRate(period, compounding, freq));
+
+                    if (d) {
+                        Time t = d->timeFromReference(couponDate);
+                        Rate r = d->zeroRate(t, compounding, frequency,
+                                             true).rate();
+                        flows.curveTimes.push_back(t);
+                        flows.zeroRates.push_back(r);
+                        flows.lowestSpreads[j] =
+                            std::max(flows.lowestSpreads[j],
+                                     lowestRate(t, compounding, freq) - r);
+                    }
+
+                    Integer thisSign = sign(amount);
+                    if (lastSign * thisSign < 0)
+                        signChanges++;
+                    if (thisSign != 0)
+                        lastSign = thisSign;
+                }
+                QL_REQUIRE(signChanges > 0,
+                           "the given cash flows cannot result in "
+                           "the given market price due to their sign");
+            } catch (std::exception& e) {
+                errors[j] = e.what();
+                Size size = flows.begin.back();
+                flows.amounts.resize(size);
+                flows.periods.resize(size);
+                flows.times.resize(size);
+                if (d) {
+                    flows.curveTimes.resize(size);
+                    flows.zeroRates.resize(size);
+                }
+            }
+        }
+        flows.begin.push_back(flows.amounts.size());
+
+        YieldObjective yieldObjective(flows, compounding, freq);
+        std::vector<Rate> yields(n, guess);
+        solve(yieldObjective, yields, flows.lowestYields,
+              accuracy, maxIterations, "yield", errors);
+
+        std::vector<Spread> zSpreads(n, Null<Spread>());
+        if (d) {
+            // same guess as zSpread()
+            std::fill(zSpreads.begin(), zSpreads.end(), 0.0);
+            ZSpreadObjective zSpreadObjective(flows, compounding, freq);
+            solve(zSpreadObjective, zSpreads, flows.lowestSpreads,
+                  accuracy, maxIterations, "z-spread", errors);
+        }
+
+        // same calculations as CashFlows::duration, convexity and
+        // basisPointValue
+        std::vector<Analytics> results(n);
+        for (Size j=0; j<n; ++j) {
+            Analytics& a = results[j];
+            a.error = errors[j];
+            Rate y = yields[j];
+            if (y == Null<Rate>()) {
+                a.yield = a.duration = a.convexity = Null<Real>();
+                a.basisPointValue = a.zSpread = Null<Real>();
+                continue;
+            }
+
+            Real P = 0.0, dPdy = 0.0, d2Pdy2 = 0.0, tP = 0.0;
+            for (Size k=flows.begin[j]; k<flows.begin[j+1]; ++k) {
+                Time t = flows.times[k];
+                Real c = flows.amounts[k];
+                DiscountFactor B = 1.0/compoundFactor(y, t, compounding, freq);
+                P += c * B;
+                tP += t * c * B;
+                Compounding comp = compounding;
+                if (comp == SimpleThenCompounded)
+                    comp = t<=1.0/freq ? Simple : Compounded;
+                switch (comp) {
+                  case Simple:
+                    dPdy -= c * B*B * t;
+                    d2Pdy2 += c * 2.0*B*B*B*t*t;
+                    break;
+                  case Compounded:
+                    dPdy -= c * t * B/(1+y/freq);
+                    d2Pdy2 += c * B*t*(freq*t+1)/(freq*(1+y/freq)*(1+y/freq));
+                    break;
+                  case Continuous:
+                    dPdy -= c * B * t;
+                    d2Pdy2 += c * B*t*t;
+                    break;
+                  default:
+                    QL_FAIL("unknown compounding convention (" <<
+                            Integer(compounding) << ")");
+                }
+            }
+
+            Real modifiedDuration = 0.0, convexity = 0.0;
+            if (P != 0.0) {
+                modifiedDuration = -dPdy/P;
+                convexity = d2Pdy2/P;
+            }
+            switch (type) {
+              case Duration::Simple:
+                a.duration = P != 0.0 ? Time(tP/P) : Time(0.0);
+                break;
+              case Duration::Modified:
+                a.duration = modifiedDuration;
+                break;
+              case Duration::Macaulay:
+                a.duration = (1.0+y/freq) * modifiedDuration;
+                break;
+              default:
+                QL_FAIL("unknown duration type");
+            }
+
+            Real npv, dummy;
+            yieldObjective.price(j, y, npv, dummy);
+            Real shift = 0.0001;
+            Real delta = -modifiedDuration*npv*shift;
+            Real gamma = (convexity/100.0)*npv*shift*shift;
+
+            a.yield = y;
+            a.convexity = convexity;
+            a.basisPointValue = delta + 0.5*gamma;
+            a.zSpread = zSpreads[j];
+        }
+        return results;
+    }
+
 }
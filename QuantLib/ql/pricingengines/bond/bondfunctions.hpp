@@ -31,6 +31,8 @@
 #include <ql/cashflow.hpp>
 #include <ql/interestrate.hpp>
 #include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
 
 namespace QuantLib {
 
@@ -205,6 +207,56 @@ namespace QuantLib {
                               Rate guess = 0.0);
         //@}
 
+        //! \name Batch analytics
+        //@{
+        //! yield-based measures and z-spread of a bond
+        struct Analytics {
+            Rate yield;
+            Time duration;
+            Real convexity;
+            Real basisPointValue;
+            Spread zSpread;
+            //! empty unless the calculation failed
+            std::string error;
+        };
+        /*! Returns, for each bond and the corresponding clean price,
+            the results of the yield(), duration(), convexity(),
+            basisPointValue() and zSpread() functions above, using the
+            same conventions for yield and z-spread; the latter is
+            null if no discount curve is given.  If no settlement date
+            is given, the one of each bond is used.
+
+            A failure for a bond (e.g., a bond that is no longer
+            tradable, or a yield or z-spread that cannot be found)
+            doesn't prevent the calculation of the others; the
+            corresponding results are null and the error is returned
+            in the error field.  Unlike the discount curve passed to
+            zSpread(), the curve is always extrapolated as needed.
+
+            The remaining cash flows of each bond are read once and
+            stored in contiguous arrays, from which all the results
+            are calculated.  Yields and z-spreads are found by
+            safeguarded Newton iterations, using the exact derivative
+            of the price; the iterations are run in lockstep for all
+            the bonds, each pass going through the arrays once.  The
+            results agree with the ones of the single-bond functions
+            within the given accuracy.
+        */
+        static std::vector<Analytics> analytics(
+                    const std::vector<boost::shared_ptr<Bond> >& bonds,
+                    const std::vector<Real>& cleanPrices,
+                    const DayCounter& dayCounter,
+                    Compounding compounding,
+                    Frequency frequency,
+                    const boost::shared_ptr<YieldTermStructure>& discount =
+                                     boost::shared_ptr<YieldTermStructure>(),
+                    Duration::Type type = Duration::Modified,
+                    Date settlementDate = Date(),
+                    Real accuracy = 1.0e-10,
+                    Size maxIterations = 100,
+                    Rate guess = 0.05);
+        //@}
+
     };
 
 }
@@ -26,6 +26,98 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        MidPointCdsLegs::MidPointCdsLegs(
+                                   const Leg& leg,
+                                   const Date& protectionStart,
+                                   const Claim& claim,
+                                   Real notional,
+                                   Real recoveryRate,
+                                   const YieldTermStructure& discountCurve,
+                                   bool settlesAccrual,
+                                   bool paysAtDefaultTime)
+        : settlementDate_(discountCurve.referenceDate()),
+          settlesAccrual_(settlesAccrual),
+          paysAtDefaultTime_(paysAtDefaultTime) {
+
+            Date today = Settings::instance().evaluationDate();
+
+            periods_.reserve(leg.size());
+            for (Size i=0; i<leg.size(); ++i) {
+                // these have occurred regardless of the settings
+                if (leg[i]->date() < settlementDate_)
+                    continue;
+
+                boost::shared_ptr<FixedRateCoupon> coupon =
+                    boost::dynamic_pointer_cast<FixedRateCoupon>(leg[i]);
+
+                Date startDate = coupon->accrualStartDate();
+                // this is the only point where it might not coincide
+                if (i==0)
+                    startDate = protectionStart;
+
+                Period p;
+                p.coupon = leg[i];
+                p.paymentDate = coupon->date();
+                p.endDate = coupon->accrualEndDate();
+                p.effectiveStartDate =
+                    (startDate <= today && today <= p.endDate) ?
+                    today : startDate;
+                Date defaultDate = // mid-point
+                    p.effectiveStartDate +
+                    (p.endDate-p.effectiveStartDate)/2;
+                p.amount = coupon->amount();
+                p.accruedAmount = coupon->accruedAmount(defaultDate);
+                p.claim = claim.amount(defaultDate, notional, recoveryRate);
+                p.paymentDiscount = discountCurve.discount(p.paymentDate);
+                p.defaultDiscount = discountCurve.discount(defaultDate);
+                periods_.push_back(p);
+            }
+        }
+
+        void MidPointCdsLegs::calculate(
+                     const DefaultProbabilityTermStructure& probability,
+                     boost::optional<bool> includeSettlementDateFlows,
+                     Real& couponLegNPV,
+                     Real& defaultLegNPV) const {
+            couponLegNPV = 0.0;
+            defaultLegNPV = 0.0;
+            for (Size i=0; i<periods_.size(); ++i) {
+                const Period& p = periods_[i];
+                if (p.coupon->hasOccurred(settlementDate_,
+                                          includeSettlementDateFlows))
+                    continue;
+
+                Probability S =
+                    probability.survivalProbability(p.paymentDate);
+                Probability P =
+                    probability.defaultProbability(p.effectiveStartDate,
+                                                   p.endDate);
+
+                // on one side, we add the fixed rate payments in case
+                // of survival...
+                couponLegNPV += S * p.amount * p.paymentDiscount;
+                // ...possibly including accrual in case of default.
+                if (settlesAccrual_) {
+                    if (paysAtDefaultTime_)
+                        couponLegNPV +=
+                            P * p.accruedAmount * p.defaultDiscount;
+                    else // pays at the end
+                        couponLegNPV += P * p.amount * p.paymentDiscount;
+                }
+
+                // on the other side, we add the payment in case of
+                // default.
+                if (paysAtDefaultTime_)
+                    defaultLegNPV += P * p.claim * p.defaultDiscount;
+                else
+                    defaultLegNPV += P * p.claim * p.paymentDiscount;
+            }
+        }
+
+    }
+
     MidPointCdsEngine::MidPointCdsEngine(
                    const Handle<DefaultProbabilityTermStructure>& probability,
                    Real recoveryRate,
@@ -44,7 +136,6 @@ namespace QuantLib {
         QL_REQUIRE(!probability_.empty(),
                    "no probability term structure set");
 
-        Date today = Settings::instance().evaluationDate();
         Date settlementDate = discountCurve_->referenceDate();
 
         // Upfront Flow NPV. Either we are on-the-run (no flow)
@@ -64,67 +155,19 @@ namespace QuantLib {
         }
         results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
 
-        results_.couponLegNPV  = 0.0;
-        results_.defaultLegNPV = 0.0;
-        for (Size i=0; i<arguments_.leg.size(); ++i) {
-            if (arguments_.leg[i]->hasOccurred(settlementDate,
-                                               includeSettlementDateFlows_))
-                continue;
-
-            boost::shared_ptr<FixedRateCoupon> coupon =
-                boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
-
-            // In order to avoid a few switches, we calculate the NPV
-            // of both legs as a positive quantity. We'll give them
-            // the right sign at the end.
-
-            Date paymentDate = coupon->date(),
-                 startDate = coupon->accrualStartDate(),
-                 endDate = coupon->accrualEndDate();
-            // this is the only point where it might not coincide
-            if (i==0)
-                startDate = arguments_.protectionStart;
-            Date effectiveStartDate =
-                (startDate <= today && today <= endDate) ? today : startDate;
-            Date defaultDate = // mid-point
-                effectiveStartDate + (endDate-effectiveStartDate)/2;
-
-            Probability S = probability_->survivalProbability(paymentDate);
-            Probability P = probability_->defaultProbability(
-                                                effectiveStartDate,
-                                                endDate);
-
-            // on one side, we add the fixed rate payments in case of
-            // survival...
-            results_.couponLegNPV +=
-                S * coupon->amount() *
-                discountCurve_->discount(paymentDate);
-            // ...possibly including accrual in case of default.
-            if (arguments_.settlesAccrual) {
-                if (arguments_.paysAtDefaultTime) {
-                    results_.couponLegNPV +=
-                        P * coupon->accruedAmount(defaultDate) *
-                        discountCurve_->discount(defaultDate);
-                } else {
-                    // pays at the end
-                    results_.couponLegNPV +=
-                        P * coupon->amount() *
-                        discountCurve_->discount(paymentDate);
-                }
-            }
-
-            // on the other side, we add the payment in case of default.
-            Real claim = arguments_.claim->amount(defaultDate,
-                                                  arguments_.notional,
-                                                  recoveryRate_);
-            if (arguments_.paysAtDefaultTime) {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(defaultDate);
-            } else {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(paymentDate);
-            }
-        }
+        // In order to avoid a few switches, we calculate the NPV
+        // of both legs as a positive quantity. We'll give them
+        // the right sign at the end.
+        detail::MidPointCdsLegs legs(arguments_.leg,
+                                     arguments_.protectionStart,
+                                     *arguments_.claim,
+                                     arguments_.notional,
+                                     recoveryRate_,
+                                     **discountCurve_,
+                                     arguments_.settlesAccrual,
+                                     arguments_.paysAtDefaultTime);
+        legs.calculate(**probability_, includeSettlementDateFlows_,
+                       results_.couponLegNPV, results_.defaultLegNPV);
 
         Real upfrontSign = 1.0;
         switch (arguments_.side) {
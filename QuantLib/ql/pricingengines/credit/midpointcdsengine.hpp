@@ -30,6 +30,46 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        //! coupon and default legs of a CDS in the mid-point approach
+        /*! The data not depending on the default curve (amounts,
+            accruals, claims and discounts at the payment and default
+            dates) are computed at construction; the legs can then be
+            calculated for different default curves, as done by the
+            bootstrap helpers.
+        */
+        class MidPointCdsLegs {
+          public:
+            MidPointCdsLegs(const Leg& leg,
+                            const Date& protectionStart,
+                            const Claim& claim,
+                            Real notional,
+                            Real recoveryRate,
+                            const YieldTermStructure& discountCurve,
+                            bool settlesAccrual,
+                            bool paysAtDefaultTime);
+            /*! Returns the NPVs of the two legs as positive
+                quantities. */
+            void calculate(
+                     const DefaultProbabilityTermStructure& probability,
+                     boost::optional<bool> includeSettlementDateFlows,
+                     Real& couponLegNPV,
+                     Real& defaultLegNPV) const;
+          private:
+            struct Period {
+                boost::shared_ptr<CashFlow> coupon;
+                Date paymentDate, effectiveStartDate, endDate;
+                Real amount, accruedAmount, claim;
+                DiscountFactor paymentDiscount, defaultDiscount;
+            };
+            std::vector<Period> periods_;
+            Date settlementDate_;
+            bool settlesAccrual_, paysAtDefaultTime_;
+        };
+
+    }
+
     class MidPointCdsEngine : public CreditDefaultSwap::engine {
       public:
         MidPointCdsEngine(
@@ -2,6 +2,7 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/swap/discountingswapportfolio.hpp>
 #include <ql/pricingengines/swap/discretizedswap.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 
@@ -0,0 +1,319 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/swap/discountingswapportfolio.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <ql/settings.hpp>
+#include <algorithm>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    namespace {
+
+        const Spread basisPoint_ = 1.0e-4;
+
+        Size dateIndex(const std::vector<Date>& dates, const Date& d) {
+            return std::lower_bound(dates.begin(), dates.end(), d)
+                 - dates.begin();
+        }
+
+    }
+
+    DiscountingSwapPortfolio::DiscountingSwapPortfolio(
+                            boost::optional<bool> includeSettlementDateFlows)
+    : includeSettlementDateFlows_(includeSettlementDateFlows),
+      dateTablesBuilt_(true) {
+        registerWith(Settings::instance().evaluationDate());
+    }
+
+    Size DiscountingSwapPortfolio::curveIndex(
+                                     const Handle<YieldTermStructure>& h) {
+        for (Size i=0; i<curves_.size(); ++i) {
+            if (curves_[i].handle == h)
+                return i;
+        }
+        Curve c;
+        c.handle = h;
+        curves_.push_back(c);
+        return curves_.size()-1;
+    }
+
+    Size DiscountingSwapPortfolio::add(
+                             const boost::shared_ptr<VanillaSwap>& swap,
+                             const Handle<YieldTermStructure>& discountCurve) {
+        QL_REQUIRE(swap, "null swap");
+
+        Position p;
+        p.swap = swap;
+        p.curve = curveIndex(discountCurve);
+        registerWith(discountCurve);
+        registerWith(swap->iborIndex());
+
+        const Leg* legs[] = { &swap->fixedLeg(), &swap->floatingLeg() };
+        p.firstFlow = flows_.size();
+        for (Size j=0; j<2; ++j) {
+            if (j == 1)
+                p.floatingFlow = flows_.size();
+            for (Size i=0; i<legs[j]->size(); ++i) {
+                const boost::shared_ptr<CashFlow>& cf = (*legs[j])[i];
+                Flow f;
+                f.cashflow = cf;
+                f.curve = p.curve;
+                f.bpsFactor = Null<Real>();
+                f.fixedAmount = Null<Real>();
+                f.iborCoupon = 0;
+
+                boost::shared_ptr<Coupon> coupon =
+                    boost::dynamic_pointer_cast<Coupon>(cf);
+                if (coupon)
+                    f.bpsFactor = coupon->nominal() * coupon->accrualPeriod();
+
+                // only the exact types are known not to override
+                // the calculation of the amount
+                if (typeid(*cf) == typeid(FixedRateCoupon)) {
+                    f.fixedAmount = cf->amount();
+                } else if (typeid(*cf) == typeid(IborCoupon)) {
+                    const IborCoupon* c =
+                        static_cast<const IborCoupon*>(cf.get());
+                    if (!c->isInArrears()) {
+                        f.iborCoupon = c;
+                        f.forwardingCurve = curveIndex(
+                                 c->iborIndex()->forwardingTermStructure());
+                        f.accrualPeriod = c->accrualPeriod();
+                    }
+                }
+                flows_.push_back(f);
+            }
+        }
+        p.endFlow = flows_.size();
+        positions_.push_back(p);
+
+        dateTablesBuilt_ = false;
+        update();
+        return positions_.size()-1;
+    }
+
+    void DiscountingSwapPortfolio::buildDateTables() const {
+        for (Size i=0; i<curves_.size(); ++i)
+            curves_[i].dates.clear();
+
+        for (Size k=0; k<flows_.size(); ++k) {
+            const Flow& f = flows_[k];
+            curves_[f.curve].dates.push_back(f.cashflow->date());
+            if (f.iborCoupon) {
+                std::vector<Date>& dates = curves_[f.forwardingCurve].dates;
+                dates.push_back(f.iborCoupon->fixingValueDate());
+                dates.push_back(f.iborCoupon->fixingEndDate());
+                dates.push_back(f.iborCoupon->date());
+            }
+        }
+
+        for (Size i=0; i<curves_.size(); ++i) {
+            std::vector<Date>& dates = curves_[i].dates;
+            std::sort(dates.begin(), dates.end());
+            dates.erase(std::unique(dates.begin(), dates.end()),
+                        dates.end());
+        }
+
+        for (Size k=0; k<flows_.size(); ++k) {
+            Flow& f = flows_[k];
+            f.payment = dateIndex(curves_[f.curve].dates, f.cashflow->date());
+            if (f.iborCoupon) {
+                const std::vector<Date>& dates =
+                    curves_[f.forwardingCurve].dates;
+                f.valueDate =
+                    dateIndex(dates, f.iborCoupon->fixingValueDate());
+                f.endDate = dateIndex(dates, f.iborCoupon->fixingEndDate());
+                f.forwardingPayment =
+                    dateIndex(dates, f.iborCoupon->date());
+            }
+        }
+
+        dateTablesBuilt_ = true;
+    }
+
+    DiscountFactor DiscountingSwapPortfolio::discount(Size curve,
+                                                      Size k) const {
+        Curve& c = curves_[curve];
+        if (c.discounts[k] == Null<DiscountFactor>())
+            c.discounts[k] = c.handle->discount(c.dates[k]);
+        return c.discounts[k];
+    }
+
+    Real DiscountingSwapPortfolio::amount(const Flow& f,
+                                          const Date& today) const {
+        if (f.fixedAmount != Null<Real>())
+            return f.fixedAmount;
+
+        const IborCoupon* c = f.iborCoupon;
+        if (c == 0
+            || c->fixingDate() <= today
+            || f.accrualPeriod == 0.0
+            || curves_[f.forwardingCurve].handle.empty())
+            return f.cashflow->amount();
+        const FloatingRateCouponPricer* pricer = c->pricer().get();
+        if (pricer == 0 || typeid(*pricer) != typeid(BlackIborCouponPricer))
+            return f.cashflow->amount();
+
+        // same operations as IborCoupon::indexFixing and
+        // BlackIborCouponPricer::swapletRate
+        Size curve = f.forwardingCurve;
+        DiscountFactor disc1 = discount(curve, f.valueDate);
+        DiscountFactor disc2 = discount(curve, f.endDate);
+        Rate fixing = (disc1/disc2 - 1.0) / c->spanningTime();
+
+        DiscountFactor d = 1.0;
+        if (c->date() > curves_[curve].referenceDate)
+            d = discount(curve, f.forwardingPayment);
+        Real spreadLegValue = c->spread() * f.accrualPeriod * d;
+        Real swapletPrice = fixing * f.accrualPeriod * d;
+        Real price = c->gearing() * swapletPrice + spreadLegValue;
+        Rate rate = price/(f.accrualPeriod*d);
+        return rate * f.accrualPeriod * c->nominal();
+    }
+
+    void DiscountingSwapPortfolio::performCalculations() const {
+        if (!dateTablesBuilt_)
+            buildDateTables();
+
+        Date today = Settings::instance().evaluationDate();
+        bool includeRefDateFlows =
+            includeSettlementDateFlows_ ?
+            *includeSettlementDateFlows_ :
+            Settings::instance().includeReferenceDateEvents();
+
+        for (Size i=0; i<curves_.size(); ++i) {
+            Curve& c = curves_[i];
+            c.discounts.assign(c.dates.size(), Null<DiscountFactor>());
+            if (!c.handle.empty()) {
+                c.referenceDate = c.handle->referenceDate();
+                c.npvDateDiscount = c.handle->discount(c.referenceDate);
+            }
+        }
+
+        Size n = positions_.size();
+        NPV_ = fixedLegNPV_ = floatingLegNPV_ = Array(n);
+        fixedLegBPS_ = floatingLegBPS_ = Array(n);
+        fairRate_ = fairSpread_ = Array(n);
+
+        for (Size i=0; i<n; ++i) {
+            const Position& p = positions_[i];
+            const VanillaSwap& swap = *p.swap;
+
+            if (swap.isExpired()) {
+                NPV_[i] = fixedLegNPV_[i] = floatingLegNPV_[i] = 0.0;
+                fixedLegBPS_[i] = floatingLegBPS_[i] = 0.0;
+                fairRate_[i] = Null<Rate>();
+                fairSpread_[i] = Null<Spread>();
+                continue;
+            }
+
+            const Curve& c = curves_[p.curve];
+            QL_REQUIRE(!c.handle.empty(),
+                       "discounting term structure handle is empty "
+                       "for swap " << i);
+            Date refDate = c.referenceDate;
+            DiscountFactor npvDateDiscount = c.npvDateDiscount;
+
+            Real payer[2];
+            if (swap.type() == VanillaSwap::Payer) {
+                payer[0] = -1.0;
+                payer[1] = +1.0;
+            } else {
+                payer[0] = +1.0;
+                payer[1] = -1.0;
+            }
+            Size bounds[] = { p.firstFlow, p.floatingFlow, p.endFlow };
+
+            Real value = 0.0;
+            Real legNPV[2], legBPS[2];
+            for (Size j=0; j<2; ++j) {
+                try {
+                    Real npv = 0.0, bps = 0.0;
+                    if (bounds[j] != bounds[j+1]) {
+                        for (Size k=bounds[j]; k<bounds[j+1]; ++k) {
+                            const Flow& f = flows_[k];
+                            if (f.cashflow->hasOccurred(refDate,
+                                                        includeRefDateFlows))
+                                continue;
+                            DiscountFactor df = discount(p.curve, f.payment);
+                            npv += amount(f, today) * df;
+                            if (f.bpsFactor != Null<Real>())
+                                bps += f.bpsFactor * df;
+                        }
+                        npv /= npvDateDiscount;
+                        bps = basisPoint_ * bps / npvDateDiscount;
+                    }
+                    legNPV[j] = npv * payer[j];
+                    legBPS[j] = bps * payer[j];
+                } catch (std::exception& e) {
+                    QL_FAIL("swap " << i << ", " << io::ordinal(j+1)
+                            << " leg: " << e.what());
+                }
+                value += legNPV[j];
+            }
+
+            NPV_[i] = value;
+            fixedLegNPV_[i] = legNPV[0];
+            floatingLegNPV_[i] = legNPV[1];
+            fixedLegBPS_[i] = legBPS[0];
+            floatingLegBPS_[i] = legBPS[1];
+            fairRate_[i] = swap.fixedRate() - value/(legBPS[0]/basisPoint_);
+            fairSpread_[i] = swap.spread() - value/(legBPS[1]/basisPoint_);
+        }
+    }
+
+    const Array& DiscountingSwapPortfolio::NPV() const {
+        calculate();
+        return NPV_;
+    }
+
+    const Array& DiscountingSwapPortfolio::fixedLegNPV() const {
+        calculate();
+        return fixedLegNPV_;
+    }
+
+    const Array& DiscountingSwapPortfolio::floatingLegNPV() const {
+        calculate();
+        return floatingLegNPV_;
+    }
+
+    const Array& DiscountingSwapPortfolio::fixedLegBPS() const {
+        calculate();
+        return fixedLegBPS_;
+    }
+
+    const Array& DiscountingSwapPortfolio::floatingLegBPS() const {
+        calculate();
+        return floatingLegBPS_;
+    }
+
+    const Array& DiscountingSwapPortfolio::fairRate() const {
+        calculate();
+        return fairRate_;
+    }
+
+    const Array& DiscountingSwapPortfolio::fairSpread() const {
+        calculate();
+        return fairSpread_;
+    }
+
+}
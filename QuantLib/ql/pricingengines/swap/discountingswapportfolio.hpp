@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file discountingswapportfolio.hpp
+    \brief portfolio-level valuation of vanilla swaps
+*/
+
+#ifndef quantlib_discounting_swap_portfolio_hpp
+#define quantlib_discounting_swap_portfolio_hpp
+
+#include <ql/instruments/vanillaswap.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/array.hpp>
+#include <ql/handle.hpp>
+
+namespace QuantLib {
+
+    class IborCoupon;
+
+    //! Portfolio-level valuation of vanilla swaps
+    /*! This class values a set of vanilla swaps as a
+        DiscountingSwapEngine with default settlement and NPV dates
+        would do, returning the results for the whole portfolio as
+        arrays.  The swaps are not modified, nor their results used;
+        each one is discounted on the curve passed together with it.
+
+        The dates at which discount factors are needed (payment dates
+        on the discounting curves; start, end and payment dates of the
+        forecast fixings on the forwarding curves) are collected once
+        for the whole portfolio and grouped by curve, so that at each
+        recalculation each curve is asked for each date only once.
+        The amounts of fixed-rate coupons are precomputed; the ones
+        of ibor coupons with a future fixing and the default Black
+        pricer are computed from the precomputed discounts with the
+        same operations performed by the coupon and its pricer, so
+        that the results match the ones of the instruments.  Any
+        other cash flow is asked for its amount.
+
+        The instance is notified of changes in the discounting
+        curves, in the indexes and in the evaluation date; it is
+        not registered with the swaps, so that changes in their
+        coupon pricers require an explicit call to recalculate().
+    */
+    class DiscountingSwapPortfolio : public LazyObject {
+      public:
+        DiscountingSwapPortfolio(
+               boost::optional<bool> includeSettlementDateFlows = boost::none);
+        //! adds a swap to the portfolio and returns its position
+        Size add(const boost::shared_ptr<VanillaSwap>& swap,
+                 const Handle<YieldTermStructure>& discountCurve);
+        //! \name Inspectors
+        //@{
+        Size size() const;
+        const boost::shared_ptr<VanillaSwap>& swap(Size i) const;
+        //@}
+        //! \name Results
+        /*! The i-th element of each array is the result for the
+            swap at the i-th position.
+        */
+        //@{
+        const Array& NPV() const;
+        const Array& fixedLegNPV() const;
+        const Array& floatingLegNPV() const;
+        const Array& fixedLegBPS() const;
+        const Array& floatingLegBPS() const;
+        const Array& fairRate() const;
+        const Array& fairSpread() const;
+        //@}
+      private:
+        struct Curve {
+            Handle<YieldTermStructure> handle;
+            std::vector<Date> dates;
+            std::vector<DiscountFactor> discounts;
+            Date referenceDate;
+            DiscountFactor npvDateDiscount;
+        };
+        struct Flow {
+            boost::shared_ptr<CashFlow> cashflow;
+            Size curve, payment;
+            Real bpsFactor;
+            // not null for fixed-rate coupons
+            Real fixedAmount;
+            // not null for ibor coupons
+            const IborCoupon* iborCoupon;
+            Size forwardingCurve, valueDate, endDate, forwardingPayment;
+            Time accrualPeriod;
+        };
+        struct Position {
+            boost::shared_ptr<VanillaSwap> swap;
+            Size curve, firstFlow, floatingFlow, endFlow;
+        };
+        void performCalculations() const;
+        Size curveIndex(const Handle<YieldTermStructure>& h);
+        void buildDateTables() const;
+        DiscountFactor discount(Size curve, Size k) const;
+        Real amount(const Flow& f, const Date& today) const;
+
+        boost::optional<bool> includeSettlementDateFlows_;
+        std::vector<Position> positions_;
+        mutable std::vector<Flow> flows_;
+        mutable std::vector<Curve> curves_;
+        mutable bool dateTablesBuilt_;
+        mutable Array NPV_, fixedLegNPV_, floatingLegNPV_;
+        mutable Array fixedLegBPS_, floatingLegBPS_;
+        mutable Array fairRate_, fairSpread_;
+    };
+
+
+    // inline definitions
+
+    inline Size DiscountingSwapPortfolio::size() const {
+        return positions_.size();
+    }
+
+    inline const boost::shared_ptr<VanillaSwap>&
+    DiscountingSwapPortfolio::swap(Size i) const {
+        QL_REQUIRE(i < positions_.size(),
+                   "position " << i << " out of range");
+        return positions_[i].swap;
+    }
+
+}
+
+#endif
@@ -44,6 +44,25 @@ namespace QuantLib {
         registerWith(blackVolatility_);
     }
 
+    GeneralizedBlackScholesProcess::GeneralizedBlackScholesProcess(
+             const Handle<Quote>& x0,
+             const Handle<YieldTermStructure>& dividendTS,
+             const Handle<YieldTermStructure>& riskFreeTS,
+             const Handle<BlackVolTermStructure>& blackVolTS,
+             const Handle<LocalVolTermStructure>& localVolTS,
+             const boost::shared_ptr<discretization>& disc)
+    : StochasticProcess1D(disc), x0_(x0), riskFreeRate_(riskFreeTS),
+      dividendYield_(dividendTS), blackVolatility_(blackVolTS),
+      updated_(false), externalLocalVolatility_(localVolTS) {
+        QL_REQUIRE(!externalLocalVolatility_.empty(),
+                   "null local volatility given");
+        registerWith(x0_);
+        registerWith(riskFreeRate_);
+        registerWith(dividendYield_);
+        registerWith(blackVolatility_);
+        registerWith(externalLocalVolatility_);
+    }
+
     Real GeneralizedBlackScholesProcess::x0() const {
         return x0_->value();
     }
@@ -110,6 +129,9 @@ namespace QuantLib {
 
     const Handle<LocalVolTermStructure>&
     GeneralizedBlackScholesProcess::localVolatility() const {
+        if (!externalLocalVolatility_.empty())
+            return externalLocalVolatility_;
+
         if (!updated_) {
 
             // constant Black vol?
@@ -53,6 +53,20 @@ namespace QuantLib {
             const Handle<BlackVolTermStructure>& blackVolTS,
             const boost::shared_ptr<discretization>& d =
                   boost::shared_ptr<discretization>(new EulerDiscretization));
+        /*! The given local volatility is used instead of the one
+            derived from the Black volatility, e.g., a
+            GriddedLocalVolSurface sampled on the grid of the engine.
+            It should be consistent with the Black volatility, which
+            is still used for analytic calculations.
+        */
+        GeneralizedBlackScholesProcess(
+            const Handle<Quote>& x0,
+            const Handle<YieldTermStructure>& dividendTS,
+            const Handle<YieldTermStructure>& riskFreeTS,
+            const Handle<BlackVolTermStructure>& blackVolTS,
+            const Handle<LocalVolTermStructure>& localVolTS,
+            const boost::shared_ptr<discretization>& d =
+                  boost::shared_ptr<discretization>(new EulerDiscretization));
         //! \name StochasticProcess1D interface
         //@{
         Real x0() const;
@@ -87,6 +101,7 @@ namespace QuantLib {
         Handle<BlackVolTermStructure> blackVolatility_;
         mutable RelinkableHandle<LocalVolTermStructure> localVolatility_;
         mutable bool updated_;
+        Handle<LocalVolTermStructure> externalLocalVolatility_;
     };
 
     //! Black-Scholes (1973) stochastic process
@@ -19,6 +19,7 @@
 */
 
 #include <ql/quotes/forwardvaluequote.hpp>
+#include <ql/settings.hpp>
 
 namespace QuantLib {
 
@@ -27,6 +28,7 @@ namespace QuantLib {
                             const Date& fixingDate)
     : index_(index), fixingDate_(fixingDate) {
         registerWith(index_);
+        registerWith(Settings::instance().evaluationDate());
     }
 
     Real ForwardValueQuote::value() const {
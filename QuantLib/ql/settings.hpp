@@ -34,6 +34,11 @@
 namespace QuantLib {
 
     //! global repository for run-time library settings
+    /*! When sessions are enabled (see the Singleton class) each
+        session has its own settings; in particular, observers of the
+        evaluation date are only notified of changes made in their
+        session.
+    */
     class Settings : public Singleton<Settings> {
         friend class Singleton<Settings>;
       private:
@@ -23,6 +23,8 @@
 #include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
+#include <ql/instruments/claim.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
 
 namespace QuantLib {
 
@@ -86,11 +88,32 @@ namespace QuantLib {
             false);
 
         resetEngine();
+        legs_.reset();
     }
 
     void CdsHelper::update() {
         RelativeDateDefaultProbabilityHelper::update();
         resetEngine();
+        legs_.reset();
+    }
+
+    void CdsHelper::legNPVs(boost::optional<bool> includeSettlementDateFlows,
+                            Real& couponLegNPV,
+                            Real& defaultLegNPV) const {
+        if (!legs_) {
+            // the swaps built by the helpers use the default claim
+            legs_ = boost::shared_ptr<detail::MidPointCdsLegs>(
+                new detail::MidPointCdsLegs(swap_->coupons(),
+                                            swap_->protectionStartDate(),
+                                            FaceValueClaim(),
+                                            swap_->notional(),
+                                            recoveryRate_,
+                                            **discountCurve_,
+                                            settlesAccrual_,
+                                            paysAtDefaultTime_));
+        }
+        legs_->calculate(**probability_, includeSettlementDateFlows,
+                         couponLegNPV, defaultLegNPV);
     }
 
     void CdsHelper::initializeDates() {
@@ -151,8 +174,11 @@ namespace QuantLib {
                 paysAtDefaultTime) {}
 
     Real SpreadCdsHelper::impliedQuote() const {
-        swap_->recalculate();
-        return swap_->fairSpread();
+        Real couponLegNPV, defaultLegNPV;
+        legNPVs(boost::none, couponLegNPV, defaultLegNPV);
+        QL_REQUIRE(couponLegNPV != 0.0, "null coupon-leg NPV");
+        // same as swap_->fairSpread(); the swap buys protection
+        return -defaultLegNPV*swap_->runningSpread()/(-couponLegNPV);
     }
 
     void SpreadCdsHelper::resetEngine() {
@@ -228,8 +254,24 @@ namespace QuantLib {
     Real UpfrontCdsHelper::impliedQuote() const {
         SavedSettings backup;
         Settings::instance().includeTodaysCashFlows() = true;
-        swap_->recalculate();
-        return swap_->fairUpfront();
+
+        Real couponLegNPV, defaultLegNPV;
+        legNPVs(true, couponLegNPV, defaultLegNPV);
+
+        // same as swap_->fairUpfront(); the swap buys protection
+        Real upfPVO1 = 0.0;
+        // the upfront is included if paid on the settlement date
+        if (upfrontDate_ >= discountCurve_->referenceDate()) {
+            Date effectiveUpfrontDate =
+                protectionStart_ > probability_->referenceDate() ?
+                    protectionStart_ : probability_->referenceDate();
+            upfPVO1 =
+                probability_->survivalProbability(effectiveUpfrontDate) *
+                discountCurve_->discount(upfrontDate_);
+        }
+        Real upfrontSensitivity = upfPVO1 * swap_->notional();
+        QL_REQUIRE(upfrontSensitivity != 0.0, "null upfront sensitivity");
+        return (defaultLegNPV - couponLegNPV) / upfrontSensitivity;
     }
 
     void UpfrontCdsHelper::resetEngine() {
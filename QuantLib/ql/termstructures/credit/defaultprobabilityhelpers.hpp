@@ -36,6 +36,10 @@ namespace QuantLib {
     class YieldTermStructure;
     class CreditDefaultSwap;
 
+    namespace detail {
+        class MidPointCdsLegs;
+    }
+
     //! alias for default-probability bootstrap helpers
     typedef BootstrapHelper<DefaultProbabilityTermStructure>
                                                      DefaultProbabilityHelper;
@@ -82,6 +86,16 @@ namespace QuantLib {
         void update();
         void initializeDates();
         virtual void resetEngine() = 0;
+        /*! Returns the NPVs of the coupon and default legs of swap_
+            (as positive quantities) with the same calculations as
+            the MidPointCdsEngine.  The data that don't depend on the
+            default curve are computed once after each reset; the
+            repricing done at each iteration of the bootstrap only
+            queries the default curve.
+        */
+        void legNPVs(boost::optional<bool> includeSettlementDateFlows,
+                     Real& couponLegNPV,
+                     Real& defaultLegNPV) const;
         Period tenor_;
         Integer settlementDays_;
         Calendar calendar_;
@@ -99,6 +113,8 @@ namespace QuantLib {
         RelinkableHandle<DefaultProbabilityTermStructure> probability_;
         //! protection effective date.
         Date protectionStart_;
+      private:
+        mutable boost::shared_ptr<detail::MidPointCdsLegs> legs_;
     };
 
     //! Spread-quoted CDS hazard rate bootstrap helper.
@@ -0,0 +1,147 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/quote.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        // index i of the interval [v[i], v[i+1]] to be used for
+        // interpolating at x, and weight of v[i+1]
+        Size locate(const std::vector<Real>& v, Real x, Real& weight) {
+            Size i = std::upper_bound(v.begin(), v.end()-1, x) - v.begin();
+            if (i > 0)
+                --i;
+            weight = (x - v[i]) / (v[i+1] - v[i]);
+            return i;
+        }
+
+    }
+
+    GriddedLocalVolSurface::GriddedLocalVolSurface(
+                                 const Handle<LocalVolTermStructure>& localVol,
+                                 const Handle<YieldTermStructure>& riskFreeTS,
+                                 const Handle<YieldTermStructure>& dividendTS,
+                                 const Handle<Quote>& underlying,
+                                 const std::vector<Time>& times,
+                                 const std::vector<Real>& logMoneyness)
+    : LocalVolTermStructure(localVol->businessDayConvention(),
+                            localVol->dayCounter()),
+      localVol_(localVol), riskFreeTS_(riskFreeTS), dividendTS_(dividendTS),
+      underlying_(underlying), times_(times), x_(logMoneyness),
+      calculated_(false) {
+        QL_REQUIRE(times_.size() >= 2, "at least two times required");
+        QL_REQUIRE(x_.size() >= 2, "at least two moneyness values required");
+        QL_REQUIRE(times_[0] >= 0.0, "negative time given");
+        for (Size i=1; i<times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be sorted and unique");
+        for (Size j=1; j<x_.size(); ++j)
+            QL_REQUIRE(x_[j] > x_[j-1],
+                       "moneyness values must be sorted and unique");
+        registerWith(localVol_);
+        registerWith(riskFreeTS_);
+        registerWith(dividendTS_);
+        registerWith(underlying_);
+    }
+
+    const Date& GriddedLocalVolSurface::referenceDate() const {
+        return localVol_->referenceDate();
+    }
+
+    Calendar GriddedLocalVolSurface::calendar() const {
+        return localVol_->calendar();
+    }
+
+    DayCounter GriddedLocalVolSurface::dayCounter() const {
+        return localVol_->dayCounter();
+    }
+
+    Date GriddedLocalVolSurface::maxDate() const {
+        return localVol_->maxDate();
+    }
+
+    Real GriddedLocalVolSurface::minStrike() const {
+        return QL_MIN_REAL;
+    }
+
+    Real GriddedLocalVolSurface::maxStrike() const {
+        return QL_MAX_REAL;
+    }
+
+    void GriddedLocalVolSurface::update() {
+        calculated_ = false;
+        LocalVolTermStructure::update();
+    }
+
+    void GriddedLocalVolSurface::accept(AcyclicVisitor& v) {
+        Visitor<GriddedLocalVolSurface>* v1 =
+            dynamic_cast<Visitor<GriddedLocalVolSurface>*>(&v);
+        if (v1 != 0)
+            v1->visit(*this);
+        else
+            LocalVolTermStructure::accept(v);
+    }
+
+    void GriddedLocalVolSurface::calculate() const {
+        if (calculated_)
+            return;
+
+        Size n = times_.size(), m = x_.size();
+        Real s0 = underlying_->value();
+        logForwards_.resize(n);
+        vols_.resize(n*m);
+        for (Size i=0; i<n; ++i) {
+            Time t = times_[i];
+            logForwards_[i] = std::log(s0 * dividendTS_->discount(t, true)
+                                          / riskFreeTS_->discount(t, true));
+            for (Size j=0; j<m; ++j)
+                vols_[i*m+j] =
+                    localVol_->localVol(t, std::exp(logForwards_[i] + x_[j]),
+                                        true);
+        }
+        calculated_ = true;
+    }
+
+    Volatility GriddedLocalVolSurface::localVolImpl(Time t,
+                                                    Real underlyingLevel)
+                                                                     const {
+        calculate();
+
+        Real a;
+        Size i = locate(times_, t, a);
+        // the forward is extrapolated linearly, the volatility flat
+        Real x = std::log(underlyingLevel)
+               - (logForwards_[i] + a*(logForwards_[i+1]-logForwards_[i]));
+        a = std::max(0.0, std::min(a, 1.0));
+
+        Real b;
+        Size j = locate(x_, x, b);
+        b = std::max(0.0, std::min(b, 1.0));
+
+        Size m = x_.size();
+        const Volatility* v0 = &vols_[i*m + j];
+        const Volatility* v1 = v0 + m;
+        return (1.0-a) * ((1.0-b)*v0[0] + b*v0[1])
+             +      a  * ((1.0-b)*v1[0] + b*v1[1]);
+    }
+
+}
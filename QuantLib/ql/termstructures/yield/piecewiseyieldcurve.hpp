@@ -30,6 +30,7 @@
 #include <ql/termstructures/localbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -53,6 +54,8 @@ namespace QuantLib {
         - the correctness of the returned values is tested by
           checking them against the original inputs.
         - the observability of the term structure is tested.
+        - the sensitivities to the quotes are tested against the
+          ones obtained by bumping the quotes and bootstrapping again.
     */
     template <class Traits, class Interpolator,
               template <class> class Bootstrap = IterativeBootstrap>
@@ -167,6 +170,32 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Sensitivities
+        //@{
+        //! rate helpers, sorted by maturity as used for the bootstrap
+        const std::vector<boost::shared_ptr<typename Traits::helper> >&
+                                                         instruments() const;
+        /*! Returns the matrix of the derivatives \f$ \partial y_i /
+            \partial q_j \f$ of the node values (excluding the one
+            at the initial date) with respect to the quotes of the
+            instruments, in the order returned by instruments();
+            the columns of expired instruments are null.
+
+            The derivatives \f$ \partial q_i / \partial y_j \f$ of
+            the quotes implied by the curve are obtained by bumping
+            the nodes, without bootstrapping again; their matrix is
+            then inverted.  The result is calculated once after each
+            bootstrap.
+        */
+        const Matrix& quoteJacobian() const;
+        /*! Returns the matrix of the derivatives \f$ \partial
+            P(d_k) / \partial q_j \f$ of the discount factors at the
+            given dates with respect to the quotes of the
+            instruments, in the order returned by instruments().
+        */
+        Disposable<Matrix> discountSensitivities(
+                                       const std::vector<Date>& dates) const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -178,9 +207,11 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void setNode(Size i, Real value) const;
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
+        mutable Matrix jacobian_;
 
         // bootstrapper classes are declared as friend to manipulate
         // the curve data. They might be passed the data instead, but
@@ -251,6 +282,98 @@ namespace QuantLib {
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
         bootstrap_.calculate();
+        jacobian_ = Matrix();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline const std::vector<boost::shared_ptr<typename C::helper> >&
+    PiecewiseYieldCurve<C,I,B>::instruments() const {
+        calculate();
+        return instruments_;
+    }
+
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::setNode(Size i,
+                                                    Real value) const {
+        C::updateGuess(this->data_, value, i);
+        this->interpolation_.update();
+    }
+
+    template <class C, class I, template <class> class B>
+    const Matrix& PiecewiseYieldCurve<C,I,B>::quoteJacobian() const {
+        calculate();
+        if (!jacobian_.empty())
+            return jacobian_;
+
+        // the alive instruments are the last ones; each of them
+        // determines the node at its maturity
+        Size n = this->data_.size()-1, m = instruments_.size();
+        Size first = m-n;
+        const Real h = 1.0e-6;
+
+        Matrix derivatives(n, n);
+        std::vector<Real> up(n), down(n);
+        const std::vector<Real> data = this->data_;
+        try {
+            for (Size j=0; j<n; ++j) {
+                setNode(j+1, data[j+1]+h);
+                for (Size i=0; i<n; ++i)
+                    up[i] = instruments_[first+i]->impliedQuote();
+                setNode(j+1, data[j+1]-h);
+                for (Size i=0; i<n; ++i)
+                    down[i] = instruments_[first+i]->impliedQuote();
+                setNode(j+1, data[j+1]);
+                for (Size i=0; i<n; ++i)
+                    derivatives[i][j] = (up[i]-down[i])/(2.0*h);
+            }
+        } catch (...) {
+            std::copy(data.begin(), data.end(), this->data_.begin());
+            this->interpolation_.update();
+            throw;
+        }
+        // leave the helpers consistent with the curve
+        for (Size i=0; i<n; ++i)
+            instruments_[first+i]->impliedQuote();
+
+        Matrix inverseDerivatives = inverse(derivatives);
+        jacobian_ = Matrix(n, m, 0.0);
+        for (Size i=0; i<n; ++i)
+            std::copy(inverseDerivatives.row_begin(i),
+                      inverseDerivatives.row_end(i),
+                      jacobian_.row_begin(i)+first);
+        return jacobian_;
+    }
+
+    template <class C, class I, template <class> class B>
+    Disposable<Matrix> PiecewiseYieldCurve<C,I,B>::discountSensitivities(
+                                      const std::vector<Date>& dates) const {
+        const Matrix& jacobian = quoteJacobian();
+
+        Size n = jacobian.rows(), k = dates.size();
+        const Real h = 1.0e-6;
+
+        Matrix derivatives(k, n);
+        std::vector<DiscountFactor> up(k);
+        const std::vector<Real> data = this->data_;
+        try {
+            for (Size j=0; j<n; ++j) {
+                setNode(j+1, data[j+1]+h);
+                for (Size i=0; i<k; ++i)
+                    up[i] = this->discount(dates[i]);
+                setNode(j+1, data[j+1]-h);
+                for (Size i=0; i<k; ++i)
+                    derivatives[i][j] =
+                        (up[i]-this->discount(dates[i]))/(2.0*h);
+                setNode(j+1, data[j+1]);
+            }
+        } catch (...) {
+            std::copy(data.begin(), data.end(), this->data_.begin());
+            this->interpolation_.update();
+            throw;
+        }
+
+        Matrix result = derivatives * jacobian;
+        return result;
     }
 
 }
@@ -21,9 +21,164 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#include <boost/thread/recursive_mutex.hpp>
+#endif
 
 namespace QuantLib {
 
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    namespace {
+        // the tables are shared among sessions; joint calendars
+        // build the tables of their members while holding the lock.
+        boost::recursive_mutex businessDaysMutex;
+        // number of replaced tables kept for each calendar
+        const Size maxReplacedBusinessDays = 16;
+    }
+    #endif
+
+    Calendar::BusinessDayTable::BusinessDayTable(const Impl& impl)
+    : first_(Date::minDate().serialNumber()), generation_(0) {
+        BigInteger last = Date::maxDate().serialNumber();
+        Size n = Size(last - first_ + 1);
+        bits_.resize(n/32 + 1, 0);
+        for (Size i=0; i<n; ++i) {
+            if (impl.isBusinessDay(Date(first_ + BigInteger(i))))
+                bits_[i/32] |= (boost::uint32_t(1) << (i%32));
+        }
+        index();
+    }
+
+    Calendar::BusinessDayTable::BusinessDayTable(const BusinessDayTable& t,
+                                                 const Impl& impl,
+                                                 unsigned long generation)
+    : first_(t.first_), bits_(t.bits_), generation_(generation) {
+        applyHolidays(impl);
+    }
+
+    Calendar::BusinessDayTable::BusinessDayTable(
+                  const std::vector<boost::shared_ptr<BusinessDayTable> >& t,
+                  bool intersection,
+                  unsigned long generation)
+    : first_(Date::minDate().serialNumber()), generation_(generation) {
+        QL_REQUIRE(!t.empty(), "no business-day tables given");
+        bits_ = t[0]->bits_;
+        for (Size k=1; k<t.size(); ++k) {
+            const std::vector<boost::uint32_t>& bits = t[k]->bits_;
+            if (intersection) {
+                for (Size j=0; j<bits_.size(); ++j)
+                    bits_[j] &= bits[j];
+            } else {
+                for (Size j=0; j<bits_.size(); ++j)
+                    bits_[j] |= bits[j];
+            }
+        }
+        index();
+    }
+
+    void Calendar::BusinessDayTable::applyHolidays(const Impl& impl) {
+        std::set<Date>::const_iterator d;
+        for (d=impl.addedHolidays.begin();
+             d!=impl.addedHolidays.end(); ++d) {
+            BigInteger i = d->serialNumber() - first_;
+            bits_[i >> 5] &= ~(boost::uint32_t(1) << (i & 31));
+        }
+        for (d=impl.removedHolidays.begin();
+             d!=impl.removedHolidays.end(); ++d) {
+            BigInteger i = d->serialNumber() - first_;
+            bits_[i >> 5] |= (boost::uint32_t(1) << (i & 31));
+        }
+        index();
+    }
+
+    void Calendar::BusinessDayTable::index() {
+        rank_.resize(bits_.size());
+        rank_[0] = 0;
+        for (Size j=1; j<rank_.size(); ++j)
+            rank_[j] = rank_[j-1] + bitCount(bits_[j-1]);
+    }
+
+    unsigned long Calendar::Impl::generation() const {
+        return holidayChanges;
+    }
+
+    boost::shared_ptr<Calendar::BusinessDayTable>
+    Calendar::Impl::buildBusinessDays(unsigned long generation) const {
+        if (!ruleBusinessDays)
+            ruleBusinessDays = boost::shared_ptr<BusinessDayTable>(
+                                                 new BusinessDayTable(*this));
+        return boost::shared_ptr<BusinessDayTable>(
+                    new BusinessDayTable(*ruleBusinessDays, *this, generation));
+    }
+
+    Date Calendar::BusinessDayTable::nthBusinessDay(BigInteger n) const {
+        if (n < 1 || n > rank_.back() + bitCount(bits_.back()))
+            return Date();
+        // the last group of dates with less than n business days
+        // before it contains the one we're looking for
+        Size j = std::upper_bound(rank_.begin(), rank_.end(),
+                                  Integer(n-1)) - rank_.begin() - 1;
+        boost::uint32_t b = bits_[j];
+        for (BigInteger k=n-rank_[j]; k>1; --k)
+            b &= b-1;  // clears the lowest bit set
+        Integer i = 0;
+        while ((b & 1) == 0) {
+            b >>= 1;
+            ++i;
+        }
+        return Date(first_ + BigInteger(32*j) + i);
+    }
+
+    const Calendar::BusinessDayTable& Calendar::updateBusinessDays() const {
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        boost::recursive_mutex::scoped_lock lock(businessDaysMutex);
+        // another session might have built it in the meantime
+        unsigned long generation = impl_->generation();
+        if (impl_->businessDays &&
+            impl_->businessDays->generation() == generation)
+            return *impl_->businessDays;
+        if (impl_->businessDays) {
+            std::vector<boost::shared_ptr<BusinessDayTable> >& replaced =
+                impl_->replacedBusinessDays;
+            if (replaced.size() >= maxReplacedBusinessDays)
+                replaced.erase(replaced.begin());
+            replaced.push_back(impl_->businessDays);
+        }
+        impl_->businessDays = impl_->buildBusinessDays(generation);
+        impl_->currentBusinessDays.store(impl_->businessDays.get(),
+                                         boost::memory_order_release);
+        #else
+        impl_->businessDays = impl_->buildBusinessDays(impl_->generation());
+        #endif
+        return *impl_->businessDays;
+    }
+
+    boost::shared_ptr<Calendar::BusinessDayTable>
+    Calendar::businessDayTable(const Calendar& c) {
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        boost::recursive_mutex::scoped_lock lock(businessDaysMutex);
+        #endif
+        c.businessDays();
+        return c.impl_->businessDays;
+    }
+
+    void Calendar::holidaysChanged() {
+        ++impl_->holidayChanges;
+    }
+
+    void Calendar::rulesChanged() {
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        boost::recursive_mutex::scoped_lock lock(businessDaysMutex);
+        #endif
+        impl_->ruleBusinessDays.reset();
+        holidaysChanged();
+    }
+
+    void Calendar::compile() {
+        compiled_ = true;
+    }
+
     void Calendar::addHoliday(const Date& d) {
         // if d was a genuine holiday previously removed, revert the change
         impl_->removedHolidays.erase(d);
@@ -31,6 +186,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        holidaysChanged();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -40,6 +196,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        holidaysChanged();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -78,6 +235,18 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            if (compiled_) {
+                const BusinessDayTable& table = businessDays();
+                BigInteger k = table.count(d);
+                if (n < 0 && table.isBusinessDay(d))
+                    --k;
+                k += (n > 0 ? n : n+1);
+                Date d1 = table.nthBusinessDay(k);
+                // out of range: fall back on the loop, which reports
+                // the error
+                if (d1 != Date())
+                    return d1;
+            }
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -121,7 +290,20 @@ namespace QuantLib {
                                              bool includeFirst,
                                              bool includeLast) const {
         BigInteger wd = 0;
-        if (from != to) {
+        if (from != to && compiled_) {
+            const BusinessDayTable& table = businessDays();
+            Date lo = std::min(from, to), hi = std::max(from, to);
+            wd = table.count(hi) - table.count(lo)
+               + (table.isBusinessDay(lo) ? 1 : 0);
+
+            if (table.isBusinessDay(from) && !includeFirst)
+                wd--;
+            if (table.isBusinessDay(to) && !includeLast)
+                wd--;
+
+            if (from > to)
+                wd = -wd;
+        } else if (from != to) {
             if (from < to) {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
@@ -29,6 +29,10 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#include <boost/atomic.hpp>
+#endif
 #include <set>
 #include <vector>
 #include <string>
@@ -57,22 +61,127 @@ namespace QuantLib {
     */
     class Calendar {
       protected:
+        class Impl;
+        //! table of the business days between the minimum and maximum date
+        class BusinessDayTable {
+          public:
+            //! table of the business days given by the calendar rules
+            explicit BusinessDayTable(const Impl&);
+            /*! Copies the given table and applies the holidays added
+                to or removed from the given calendar.
+            */
+            BusinessDayTable(const BusinessDayTable&,
+                             const Impl&,
+                             unsigned long generation);
+            /*! Combines the given tables; a date is a business day
+                for the result if it's a business day for all of them
+                (if <tt>intersection</tt> is true) or for any of them.
+            */
+            BusinessDayTable(
+                const std::vector<boost::shared_ptr<BusinessDayTable> >&,
+                bool intersection,
+                unsigned long generation);
+            bool isBusinessDay(const Date& d) const;
+            //! number of business days up to the given date (included)
+            BigInteger count(const Date& d) const;
+            //! the n-th business day (counting from 1), if any
+            Date nthBusinessDay(BigInteger n) const;
+            //! generation of the calendar the table reflects
+            unsigned long generation() const { return generation_; }
+          private:
+            static Integer bitCount(boost::uint32_t);
+            void applyHolidays(const Impl&);
+            void index();
+            BigInteger first_;
+            // bit i%32 of bits_[i/32] is set iff the i-th date is
+            // a business day; rank_[j] counts the business days
+            // before the dates in bits_[j].
+            std::vector<boost::uint32_t> bits_;
+            std::vector<Integer> rank_;
+            unsigned long generation_;
+        };
         //! abstract base class for calendar implementations
         class Impl {
           public:
+            #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            Impl() : holidayChanges(0), currentBusinessDays(0) {}
+            #else
+            Impl() : holidayChanges(0) {}
+            #endif
             virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            /*! Returns the number of changes in the holidays or
+                weekends of the calendar; derived classes depending
+                on other calendars must add the generations of the
+                latter, so that their tables are rebuilt when any of
+                them changes.
+            */
+            virtual unsigned long generation() const;
+            /*! Builds the table of business days. The default
+                implementation evaluates isBusinessDay() for each date
+                the first time it's called and keeps the result, so
+                that changes in the holidays only need to be applied
+                to a copy of it; derived classes can override it if
+                they can do better.
+                When thread-local sessions are enabled, it's only
+                called while holding the lock that serializes the
+                construction of the tables, so that overrides can use
+                shared data.
+            */
+            virtual boost::shared_ptr<BusinessDayTable>
+            buildBusinessDays(unsigned long generation) const;
             std::set<Date> addedHolidays, removedHolidays;
+            #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            boost::atomic<unsigned long> holidayChanges;
+            #else
+            unsigned long holidayChanges;
+            #endif
+            //! business days given by the rules, before any change
+            mutable boost::shared_ptr<BusinessDayTable> ruleBusinessDays;
+            mutable boost::shared_ptr<BusinessDayTable> businessDays;
+            #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            /* The table in use, which sessions read without locking;
+               it's only replaced while holding the lock.  The last
+               replaced tables are kept alive, since other sessions
+               might still be in the middle of a lookup; holidays are
+               meant to be modified before sessions start, so a
+               lookup in progress can only be using one of the last
+               few.
+            */
+            mutable boost::atomic<const BusinessDayTable*>
+                                                      currentBusinessDays;
+            mutable std::vector<boost::shared_ptr<BusinessDayTable> >
+                                                      replacedBusinessDays;
+            #endif
         };
         boost::shared_ptr<Impl> impl_;
+        bool compiled_;
+        /*! Returns the table of business days, building it if it
+            doesn't exist or it's outdated.  It can be used whether or
+            not the calendar is compiled.
+        */
+        const BusinessDayTable& businessDays() const;
+        //! the up-to-date table of business days of the given calendar
+        static boost::shared_ptr<BusinessDayTable> businessDayTable(
+                                                          const Calendar&);
+        /*! Must be called after any change in the holidays of the
+            calendar, so that its table of business days is rebuilt.
+        */
+        void holidaysChanged();
+        /*! Must be called after any change in the rules of the
+            calendar (e.g., its weekends) instead of holidaysChanged().
+        */
+        void rulesChanged();
+      private:
+        const BusinessDayTable& updateBusinessDays() const;
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
             placeholder.
         */
-        Calendar() {}
+        Calendar() : compiled_(false) {}
         //! \name Calendar interface
         //@{
         //!  Returns whether or not the calendar is initialized
@@ -102,7 +211,11 @@ namespace QuantLib {
         //! last business day of the month to which the given date belongs
         Date endOfMonth(const Date& d) const;
 
-        /*! Adds a date to the set of holidays for the given calendar. */
+        /*! Adds a date to the set of holidays for the given calendar.
+
+            \warning holidays are shared by all sessions, if enabled;
+                     they should be modified before any session starts.
+        */
         void addHoliday(const Date&);
         /*! Removes a date from the set of holidays for the given calendar. */
         void removeHoliday(const Date&);
@@ -143,6 +256,29 @@ namespace QuantLib {
                                        bool includeFirst = true,
                                        bool includeLast = false) const;
         //@}
+        //! \name Precomputed business days
+        //@{
+        /*! Makes the calendar use a precomputed table of its business
+            days between Date::minDate() and Date::maxDate(), built at
+            its first use.  isBusinessDay() becomes a bit lookup, while
+            advance() by a number of days and businessDaysBetween()
+            take constant time.  The table is rebuilt when holidays
+            are added or removed.
+
+            The setting is kept by copies of this instance; the table
+            itself is shared among all the calendars with the same
+            implementation (e.g., all instances of TARGET.)
+        */
+        void compile();
+        //! Returns whether the calendar uses precomputed business days
+        bool isCompiled() const;
+        /*! Returns a counter increased at each change in the holidays
+            or weekends of the calendar (or of the calendars it's
+            made of); it can be used to detect when results depending
+            on its business days are outdated.
+        */
+        unsigned long generation() const;
+        //@}
 
       protected:
         //! partial calendar implementation
@@ -192,7 +328,49 @@ namespace QuantLib {
         return impl_->name();
     }
 
+    inline Integer Calendar::BusinessDayTable::bitCount(boost::uint32_t x) {
+        x = x - ((x >> 1) & 0x55555555);
+        x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+        x = (x + (x >> 4)) & 0x0F0F0F0F;
+        return Integer((x * 0x01010101) >> 24);
+    }
+
+    inline bool
+    Calendar::BusinessDayTable::isBusinessDay(const Date& d) const {
+        BigInteger i = d.serialNumber() - first_;
+        return ((bits_[i >> 5] >> (i & 31)) & 1) != 0;
+    }
+
+    inline BigInteger
+    Calendar::BusinessDayTable::count(const Date& d) const {
+        BigInteger i = d.serialNumber() - first_;
+        boost::uint32_t mask = 0xFFFFFFFFu >> (31 - (i & 31));
+        return rank_[i >> 5] + bitCount(bits_[i >> 5] & mask);
+    }
+
+    inline const Calendar::BusinessDayTable& Calendar::businessDays() const {
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        const BusinessDayTable* table =
+            impl_->currentBusinessDays.load(boost::memory_order_acquire);
+        #else
+        const BusinessDayTable* table = impl_->businessDays.get();
+        #endif
+        if (!table || table->generation() != impl_->generation())
+            return updateBusinessDays();
+        return *table;
+    }
+
+    inline unsigned long Calendar::generation() const {
+        return impl_->generation();
+    }
+
+    inline bool Calendar::isCompiled() const {
+        return compiled_;
+    }
+
     inline bool Calendar::isBusinessDay(const Date& d) const {
+        if (compiled_)
+            return businessDays().isBusinessDay(d);
         if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
             return false;
         if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
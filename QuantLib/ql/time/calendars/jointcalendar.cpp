@@ -21,6 +21,8 @@
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/errors.hpp>
 #include <sstream>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
@@ -114,6 +116,79 @@ namespace QuantLib {
         }
     }
 
+    unsigned long JointCalendar::Impl::generation() const {
+        unsigned long g = holidayChanges;
+        for (Size i=0; i<calendars_.size(); ++i)
+            g += calendars_[i].generation();
+        return g;
+    }
+
+    boost::shared_ptr<Calendar::BusinessDayTable>
+    JointCalendar::Impl::buildBusinessDays(unsigned long generation) const {
+        typedef std::vector<boost::shared_ptr<BusinessDayTable> > tables;
+        typedef std::vector<std::pair<std::string, unsigned long> > members;
+        typedef std::pair<JointCalendarRule, members> key;
+        typedef std::list<key> usage_list;
+        typedef std::map<key, std::pair<tables::value_type,
+                                        usage_list::iterator> > table_map;
+        // combined tables, shared among joint calendars with the same
+        // rule and the same underlying calendars.  The latter are
+        // identified by their name, as in the comparison between
+        // calendars, and by their generation, so that the entries
+        // built before a change in their holidays are no longer used;
+        // the least recently used entry is discarded when the cache
+        // is full.
+        // With thread-local sessions, this is only run while holding
+        // the lock on the tables, which protects the cache as well.
+        static const Size maxCachedTables = 32;
+        static table_map cache;
+        static usage_list usage;
+
+        // the combined table reflects the changes in the underlying
+        // calendars; the ones in this calendar are applied below
+        unsigned long changes = holidayChanges;
+        key k(rule_, members(calendars_.size()));
+        for (Size i=0; i<calendars_.size(); ++i) {
+            k.second[i].first = calendars_[i].name();
+            k.second[i].second = calendars_[i].generation();
+        }
+
+        tables::value_type combined;
+        table_map::iterator entry = cache.find(k);
+        if (entry != cache.end()) {
+            usage.splice(usage.begin(), usage, entry->second.second);
+            combined = entry->second.first;
+        } else {
+            tables t(calendars_.size());
+            for (Size i=0; i<calendars_.size(); ++i)
+                t[i] = businessDayTable(calendars_[i]);
+            switch (rule_) {
+              case JoinHolidays:
+                combined = tables::value_type(new BusinessDayTable(
+                                         t, true, generation - changes));
+                break;
+              case JoinBusinessDays:
+                combined = tables::value_type(new BusinessDayTable(
+                                        t, false, generation - changes));
+                break;
+              default:
+                QL_FAIL("unknown joint calendar rule");
+            }
+            if (cache.size() >= maxCachedTables) {
+                cache.erase(usage.back());
+                usage.pop_back();
+            }
+            usage.push_front(k);
+            cache[k] = std::make_pair(combined, usage.begin());
+        }
+
+        if (changes == 0)
+            return combined;
+        // holidays were edited for this joint calendar only
+        return tables::value_type(
+                         new BusinessDayTable(*combined, *this, generation));
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
@@ -46,6 +46,13 @@ namespace QuantLib {
         business days given by either the union or the intersection
         of the sets of business days of the given calendars.
 
+        When a joint calendar is compiled, its table of business days
+        is obtained by combining the tables of the given calendars bit
+        by bit instead of querying each calendar for each date, and is
+        shared between joint calendars having the same rule and the
+        same underlying calendars; a limited number of such tables is
+        kept.
+
         \ingroup calendars
 
         \test the correctness of the returned results is tested by
@@ -65,6 +72,9 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+            unsigned long generation() const;
+            boost::shared_ptr<BusinessDayTable>
+            buildBusinessDays(unsigned long generation) const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
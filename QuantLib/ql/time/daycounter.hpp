@@ -27,6 +27,7 @@
 
 #include <ql/time/date.hpp>
 #include <ql/errors.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -56,6 +57,22 @@ namespace QuantLib {
                                       const Date& d2,
                                       const Date& refPeriodStart,
                                       const Date& refPeriodEnd) const = 0;
+            /*! to be overloaded by day counters that can avoid a
+                virtual call per pair of dates.  Empty vectors of
+                reference dates stand for null dates.
+            */
+            virtual void yearFractions(
+                                  const std::vector<Date>& d1,
+                                  const std::vector<Date>& d2,
+                                  const std::vector<Date>& refPeriodStart,
+                                  const std::vector<Date>& refPeriodEnd,
+                                  std::vector<Time>& result) const {
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = yearFraction(
+                        d1[i], d2[i],
+                        refPeriodStart.empty() ? Date() : refPeriodStart[i],
+                        refPeriodEnd.empty() ? Date() : refPeriodEnd[i]);
+            }
         };
         boost::shared_ptr<Impl> impl_;
         /*! This constructor can be invoked by derived classes which
@@ -86,6 +103,26 @@ namespace QuantLib {
                           const Date& refPeriodStart = Date(),
                           const Date& refPeriodEnd = Date()) const;
         //@}
+        //! \name Batch calculations
+        //@{
+        //! Returns the year fractions between the given pairs of dates.
+        std::vector<Time> yearFractions(const std::vector<Date>& d1,
+                                        const std::vector<Date>& d2) const;
+        /*! Returns the year fractions between the given pairs of
+            dates, using the given reference periods.
+        */
+        std::vector<Time> yearFractions(
+                              const std::vector<Date>& d1,
+                              const std::vector<Date>& d2,
+                              const std::vector<Date>& refPeriodStart,
+                              const std::vector<Date>& refPeriodEnd) const;
+        /*! Returns the year fractions between the given date and
+            each of the given dates, e.g., the times of a term
+            structure's nodes.
+        */
+        std::vector<Time> yearFractions(const Date& d1,
+                                        const std::vector<Date>& d2) const;
+        //@}
     };
 
     // comparison based on name
@@ -129,6 +166,44 @@ namespace QuantLib {
             return impl_->yearFraction(d1,d2,refPeriodStart,refPeriodEnd);
     }
 
+    inline std::vector<Time>
+    DayCounter::yearFractions(const std::vector<Date>& d1,
+                              const std::vector<Date>& d2) const {
+        return yearFractions(d1, d2,
+                             std::vector<Date>(), std::vector<Date>());
+    }
+
+    inline std::vector<Time> DayCounter::yearFractions(
+                           const std::vector<Date>& d1,
+                           const std::vector<Date>& d2,
+                           const std::vector<Date>& refPeriodStart,
+                           const std::vector<Date>& refPeriodEnd) const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        QL_REQUIRE(d1.size() == d2.size(),
+                   "mismatch between number of start dates (" << d1.size()
+                   << ") and end dates (" << d2.size() << ")");
+        QL_REQUIRE(refPeriodStart.empty() ||
+                   refPeriodStart.size() == d1.size(),
+                   "wrong number of reference-period start dates ("
+                   << refPeriodStart.size() << ", " << d1.size()
+                   << " required)");
+        QL_REQUIRE(refPeriodEnd.empty() ||
+                   refPeriodEnd.size() == d1.size(),
+                   "wrong number of reference-period end dates ("
+                   << refPeriodEnd.size() << ", " << d1.size()
+                   << " required)");
+        std::vector<Time> result(d1.size());
+        impl_->yearFractions(d1, d2, refPeriodStart, refPeriodEnd, result);
+        return result;
+    }
+
+    inline std::vector<Time>
+    DayCounter::yearFractions(const Date& d1,
+                              const std::vector<Date>& d2) const {
+        return yearFractions(std::vector<Date>(d2.size(), d1), d2,
+                             std::vector<Date>(), std::vector<Date>());
+    }
+
 
     inline bool operator==(const DayCounter& d1, const DayCounter& d2) {
         return (d1.empty() && d2.empty())
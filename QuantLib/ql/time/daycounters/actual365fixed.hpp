@@ -52,6 +52,14 @@ namespace QuantLib {
                               const Date&) const {
                 return dayCount(d1,d2)/365.0;
             }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const {
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = (d2[i]-d1[i])/365.0;
+            }
         };
       public:
         Actual365Fixed()
@@ -137,6 +137,67 @@ namespace QuantLib {
         }
     }
 
+    void ActualActual::ISMA_Impl::yearFractions(
+                                     const std::vector<Date>& d1,
+                                     const std::vector<Date>& d2,
+                                     const std::vector<Date>& refPeriodStart,
+                                     const std::vector<Date>& refPeriodEnd,
+                                     std::vector<Time>& result) const {
+        for (Size i=0; i<d1.size(); ++i) {
+            Date d3 = refPeriodStart.empty() ? Date() : refPeriodStart[i];
+            Date d4 = refPeriodEnd.empty() ? Date() : refPeriodEnd[i];
+            Date start = (d3 != Date() ? d3 : d1[i]);
+            Date end = (d4 != Date() ? d4 : d2[i]);
+            // the most common case, i.e., a regular period, is
+            // calculated directly; the others (including the null
+            // and invalid periods) are left to the general method.
+            if (start <= d1[i] && d1[i] < d2[i] && d2[i] <= end) {
+                Integer months = Integer(0.5+12*Real(end-start)/365);
+                if (months != 0) {
+                    Time period = Real(months)/12.0;
+                    result[i] = period*Real(d2[i]-d1[i]) / (end-start);
+                    continue;
+                }
+            }
+            result[i] = ISMA_Impl::yearFraction(d1[i], d2[i], d3, d4);
+        }
+    }
+
+    void ActualActual::ISDA_Impl::yearFractions(
+                                     const std::vector<Date>& d1,
+                                     const std::vector<Date>& d2,
+                                     const std::vector<Date>&,
+                                     const std::vector<Date>&,
+                                     std::vector<Time>& result) const {
+        // the first days of the years are kept from one pair of dates
+        // to the next, since the dates are usually close
+        Year year1 = 0, year2 = 0;
+        Date start1, start2;
+        for (Size i=0; i<d1.size(); ++i) {
+            if (d1[i] >= d2[i]) {
+                result[i] = ISDA_Impl::yearFraction(d1[i], d2[i],
+                                                    Date(), Date());
+                continue;
+            }
+            Year y1 = d1[i].year(), y2 = d2[i].year();
+            if (y1 != year1) {
+                year1 = y1;
+                start1 = Date(1, January, y1+1);
+            }
+            if (y2 != year2) {
+                year2 = y2;
+                start2 = Date(1, January, y2);
+            }
+            Real dib1 = (Date::isLeap(y1) ? 366.0 : 365.0),
+                 dib2 = (Date::isLeap(y2) ? 366.0 : 365.0);
+
+            Time sum = y2 - y1 - 1;
+            sum += (start1 - d1[i])/dib1;
+            sum += (d2[i] - start2)/dib2;
+            result[i] = sum;
+        }
+    }
+
     Time ActualActual::ISDA_Impl::yearFraction(const Date& d1,
                                                const Date& d2,
                                                const Date&,
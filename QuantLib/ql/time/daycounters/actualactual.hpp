@@ -61,6 +61,11 @@ namespace QuantLib {
                               const Date& d2,
                               const Date& refPeriodStart,
                               const Date& refPeriodEnd) const;
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>& refPeriodStart,
+                               const std::vector<Date>& refPeriodEnd,
+                               std::vector<Time>& result) const;
         };
         class ISDA_Impl : public DayCounter::Impl {
           public:
@@ -71,6 +76,11 @@ namespace QuantLib {
                               const Date& d2,
                               const Date&,
                               const Date&) const;
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const;
         };
         class AFB_Impl : public DayCounter::Impl {
           public:
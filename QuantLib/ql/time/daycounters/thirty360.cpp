@@ -21,6 +21,45 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // the kernels are kept out of the implementations so that
+        // the batch calculations can inline them
+
+        inline BigInteger usDayCount(const Date& d1, const Date& d2) {
+            Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
+            Integer mm1 = d1.month(), mm2 = d2.month();
+            Year yy1 = d1.year(), yy2 = d2.year();
+
+            if (dd2 == 31 && dd1 < 30) { dd2 = 1; mm2++; }
+
+            return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
+                std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+        }
+
+        inline BigInteger euDayCount(const Date& d1, const Date& d2) {
+            Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
+            Month mm1 = d1.month(), mm2 = d2.month();
+            Year yy1 = d1.year(), yy2 = d2.year();
+
+            return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
+                std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+        }
+
+        inline BigInteger itDayCount(const Date& d1, const Date& d2) {
+            Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
+            Month mm1 = d1.month(), mm2 = d2.month();
+            Year yy1 = d1.year(), yy2 = d2.year();
+
+            if (mm1 == 2 && dd1 > 27) dd1 = 30;
+            if (mm2 == 2 && dd2 > 27) dd2 = 30;
+
+            return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
+                std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+        }
+
+    }
+
     boost::shared_ptr<DayCounter::Impl>
     Thirty360::implementation(Thirty360::Convention c) {
         switch (c) {
@@ -39,37 +78,44 @@ namespace QuantLib {
 
     BigInteger Thirty360::US_Impl::dayCount(const Date& d1,
                                             const Date& d2) const {
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Integer mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
-
-        if (dd2 == 31 && dd1 < 30) { dd2 = 1; mm2++; }
+        return usDayCount(d1, d2);
+    }
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    void Thirty360::US_Impl::yearFractions(const std::vector<Date>& d1,
+                                           const std::vector<Date>& d2,
+                                           const std::vector<Date>&,
+                                           const std::vector<Date>&,
+                                           std::vector<Time>& result) const {
+        for (Size i=0; i<d1.size(); ++i)
+            result[i] = usDayCount(d1[i], d2[i])/360.0;
     }
 
     BigInteger Thirty360::EU_Impl::dayCount(const Date& d1,
                                             const Date& d2) const {
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
+        return euDayCount(d1, d2);
+    }
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    void Thirty360::EU_Impl::yearFractions(const std::vector<Date>& d1,
+                                           const std::vector<Date>& d2,
+                                           const std::vector<Date>&,
+                                           const std::vector<Date>&,
+                                           std::vector<Time>& result) const {
+        for (Size i=0; i<d1.size(); ++i)
+            result[i] = euDayCount(d1[i], d2[i])/360.0;
     }
 
     BigInteger Thirty360::IT_Impl::dayCount(const Date& d1,
                                             const Date& d2) const {
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
-
-        if (mm1 == 2 && dd1 > 27) dd1 = 30;
-        if (mm2 == 2 && dd2 > 27) dd2 = 30;
+        return itDayCount(d1, d2);
+    }
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    void Thirty360::IT_Impl::yearFractions(const std::vector<Date>& d1,
+                                           const std::vector<Date>& d2,
+                                           const std::vector<Date>&,
+                                           const std::vector<Date>&,
+                                           std::vector<Time>& result) const {
+        for (Size i=0; i<d1.size(); ++i)
+            result[i] = itDayCount(d1[i], d2[i])/360.0;
     }
 
 }
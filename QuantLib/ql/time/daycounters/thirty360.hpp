@@ -67,6 +67,11 @@ namespace QuantLib {
                               const Date&, 
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const;
         };
         class EU_Impl : public DayCounter::Impl {
           public:
@@ -78,6 +83,11 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const;
         };
         class IT_Impl : public DayCounter::Impl {
           public:
@@ -88,6 +98,11 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const;
         };
         static boost::shared_ptr<DayCounter::Impl> implementation(
                                                                Convention c);
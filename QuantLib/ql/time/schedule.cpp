@@ -20,8 +20,10 @@
 */
 
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/imm.hpp>
 #include <ql/settings.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -457,7 +459,7 @@ namespace QuantLib {
 
 
     MakeSchedule::MakeSchedule()
-    : rule_(DateGeneration::Backward), endOfMonth_(false) {}
+    : rule_(DateGeneration::Backward), endOfMonth_(false), cached_(false) {}
 
     MakeSchedule& MakeSchedule::from(const Date& effectiveDate) {
         effectiveDate_ = effectiveDate;
@@ -525,46 +527,107 @@ namespace QuantLib {
         return *this;
     }
 
-    MakeSchedule::operator Schedule() const {
-        // check for mandatory arguments
-        QL_REQUIRE(effectiveDate_ != Date(), "effective date not provided");
-        QL_REQUIRE(terminationDate_ != Date(), "termination date not provided");
+    MakeSchedule& MakeSchedule::cached(bool flag) {
+        cached_ = flag;
+        return *this;
+    }
+
+    void MakeSchedule::checkArguments() const {
         QL_REQUIRE(tenor_, "tenor/frequency not provided");
+    }
 
-        // set dynamic defaults:
-        BusinessDayConvention convention;
+    BusinessDayConvention MakeSchedule::convention() const {
         // if a convention was set, we use it.
-        if (convention_) {
-            convention = *convention_;
+        if (convention_)
+            return *convention_;
+        if (!calendar_.empty()) {
+            // ...if we set a calendar, we probably want it to be used;
+            return Following;
         } else {
-            if (!calendar_.empty()) {
-                // ...if we set a calendar, we probably want it to be used;
-                convention = Following;
-            } else {
-                // if not, we don't care.
-                convention = Unadjusted;
-            }
+            // if not, we don't care.
+            return Unadjusted;
         }
+    }
 
-        BusinessDayConvention terminationDateConvention;
+    BusinessDayConvention MakeSchedule::terminationDateConvention() const {
         // if set explicitly, we use it;
-        if (terminationDateConvention_) {
-            terminationDateConvention = *terminationDateConvention_;
-        } else {
-            // Unadjusted as per ISDA specification
-            terminationDateConvention = convention;
-        }
+        if (terminationDateConvention_)
+            return *terminationDateConvention_;
+        // Unadjusted as per ISDA specification
+        return convention();
+    }
 
-        Calendar calendar = calendar_;
-        // if no calendar was set...
-        if (calendar.empty()) {
-            // ...we use a null one.
-            calendar = NullCalendar();
-        }
+    Calendar MakeSchedule::calendar() const {
+        // if no calendar was set, we use a null one.
+        if (calendar_.empty())
+            return NullCalendar();
+        return calendar_;
+    }
 
-        return Schedule(effectiveDate_, terminationDate_, *tenor_, calendar,
-                        convention, terminationDateConvention,
-                        rule_, endOfMonth_, firstDate_, nextToLastDate_);
+    boost::shared_ptr<const Schedule> MakeSchedule::schedule(
+                                         const Date& effectiveDate,
+                                         const Date& terminationDate,
+                                         const Calendar& calendar) const {
+        if (cached_)
+            return ScheduleCache::instance().schedule(
+                                   effectiveDate, terminationDate, *tenor_,
+                                   calendar, convention(),
+                                   terminationDateConvention(), rule_,
+                                   endOfMonth_, firstDate_, nextToLastDate_);
+        return boost::shared_ptr<const Schedule>(
+                  new Schedule(effectiveDate, terminationDate, *tenor_,
+                               calendar, convention(),
+                               terminationDateConvention(), rule_,
+                               endOfMonth_, firstDate_, nextToLastDate_));
+    }
+
+    MakeSchedule::operator Schedule() const {
+        return *shared();
+    }
+
+    boost::shared_ptr<const Schedule> MakeSchedule::shared() const {
+        // check for mandatory arguments
+        QL_REQUIRE(effectiveDate_ != Date(), "effective date not provided");
+        QL_REQUIRE(terminationDate_ != Date(), "termination date not provided");
+        checkArguments();
+
+        return schedule(effectiveDate_, terminationDate_, calendar());
+    }
+
+    std::vector<boost::shared_ptr<const Schedule> > MakeSchedule::schedules(
+                            const std::vector<Date>& effectiveDates,
+                            const std::vector<Date>& terminationDates) const {
+        QL_REQUIRE(effectiveDates.size() == terminationDates.size(),
+                   "mismatch between number of effective dates ("
+                   << effectiveDates.size() << ") and termination dates ("
+                   << terminationDates.size() << ")");
+        checkArguments();
+
+        // the business-day table is built (or retrieved) only once
+        Calendar calendar = this->calendar();
+        calendar.compile();
+
+        std::vector<boost::shared_ptr<const Schedule> > result;
+        result.reserve(effectiveDates.size());
+        std::map<std::pair<Date,Date>, Size> generated;
+        for (Size i=0; i<effectiveDates.size(); ++i) {
+            QL_REQUIRE(effectiveDates[i] != Date(),
+                       "effective date #" << i+1 << " not provided");
+            QL_REQUIRE(terminationDates[i] != Date(),
+                       "termination date #" << i+1 << " not provided");
+            std::pair<Date,Date> dates(effectiveDates[i],
+                                       terminationDates[i]);
+            std::map<std::pair<Date,Date>, Size>::const_iterator j =
+                generated.find(dates);
+            if (j != generated.end()) {
+                result.push_back(result[j->second]);
+            } else {
+                generated[dates] = i;
+                result.push_back(schedule(dates.first, dates.second,
+                                          calendar));
+            }
+        }
+        return result;
     }
 
 }
@@ -32,6 +32,7 @@
 #include <ql/time/dategenerationrule.hpp>
 #include <ql/errors.hpp>
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace QuantLib {
 
@@ -121,8 +122,34 @@ namespace QuantLib {
         MakeSchedule& endOfMonth(bool flag=true);
         MakeSchedule& withFirstDate(const Date& d);
         MakeSchedule& withNextToLastDate(const Date& d);
+        /*! If set, schedules are retrieved from (and stored into)
+            the ScheduleCache instead of being generated each time.
+        */
+        MakeSchedule& cached(bool flag=true);
         operator Schedule() const;
+        //! returns the schedule without copying it
+        /*! When the schedule is cached, the returned instance is
+            the one stored in the ScheduleCache.
+        */
+        boost::shared_ptr<const Schedule> shared() const;
+        //! schedules for the given pairs of effective and termination dates
+        /*! All other parameters are the ones set for this instance.
+            The schedules are generated in a single pass: the
+            calendar is compiled once for all of them, and schedules
+            with the same dates are generated only once and shared.
+        */
+        std::vector<boost::shared_ptr<const Schedule> > schedules(
+                           const std::vector<Date>& effectiveDates,
+                           const std::vector<Date>& terminationDates) const;
       private:
+        void checkArguments() const;
+        BusinessDayConvention convention() const;
+        BusinessDayConvention terminationDateConvention() const;
+        Calendar calendar() const;
+        boost::shared_ptr<const Schedule> schedule(
+                                         const Date& effectiveDate,
+                                         const Date& terminationDate,
+                                         const Calendar& calendar) const;
         Calendar calendar_;
         Date effectiveDate_, terminationDate_;
         boost::optional<Period> tenor_;
@@ -131,6 +158,7 @@ namespace QuantLib {
         DateGeneration::Rule rule_;
         bool endOfMonth_;
         Date firstDate_, nextToLastDate_;
+        bool cached_;
     };
 
 
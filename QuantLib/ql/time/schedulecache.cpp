@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+
+namespace QuantLib {
+
+    bool ScheduleCache::Key::operator<(const Key& k) const {
+        if (effectiveDate != k.effectiveDate)
+            return effectiveDate < k.effectiveDate;
+        if (terminationDate != k.terminationDate)
+            return terminationDate < k.terminationDate;
+        // periods are compared by their components, since the
+        // comparison between them is not a strict ordering
+        // (e.g., 1 year and 12 months are neither smaller nor
+        // larger than each other) and they result in different
+        // schedules anyway.
+        if (tenor.length() != k.tenor.length())
+            return tenor.length() < k.tenor.length();
+        if (tenor.units() != k.tenor.units())
+            return tenor.units() < k.tenor.units();
+        if (convention != k.convention)
+            return convention < k.convention;
+        if (terminationDateConvention != k.terminationDateConvention)
+            return terminationDateConvention < k.terminationDateConvention;
+        if (rule != k.rule)
+            return rule < k.rule;
+        if (endOfMonth != k.endOfMonth)
+            return endOfMonth < k.endOfMonth;
+        if (firstDate != k.firstDate)
+            return firstDate < k.firstDate;
+        if (nextToLastDate != k.nextToLastDate)
+            return nextToLastDate < k.nextToLastDate;
+        return calendar < k.calendar;
+    }
+
+    boost::shared_ptr<const Schedule> ScheduleCache::schedule(
+                          const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate,
+                          const Date& nextToLastDate) {
+        if (effectiveDate == Date())
+            return boost::shared_ptr<const Schedule>(
+                   new Schedule(effectiveDate, terminationDate, tenor,
+                                calendar, convention,
+                                terminationDateConvention, rule,
+                                endOfMonth, firstDate, nextToLastDate));
+
+        Key k;
+        k.effectiveDate = effectiveDate;
+        k.terminationDate = terminationDate;
+        k.tenor = tenor;
+        k.calendar = calendar.name();
+        k.convention = convention;
+        k.terminationDateConvention = terminationDateConvention;
+        k.rule = rule;
+        k.endOfMonth = endOfMonth;
+        k.firstDate = firstDate;
+        k.nextToLastDate = nextToLastDate;
+
+        unsigned long generation = calendar.generation();
+        schedule_map::iterator i = data_.lower_bound(k);
+        if (i != data_.end() && !(k < i->first)) {
+            usage_.splice(usage_.begin(), usage_, i->second.use);
+            if (i->second.generation != generation) {
+                // the holidays changed; the new schedule replaces
+                // the stored one
+                i->second.schedule = boost::shared_ptr<const Schedule>(
+                   new Schedule(effectiveDate, terminationDate, tenor,
+                                calendar, convention,
+                                terminationDateConvention, rule,
+                                endOfMonth, firstDate, nextToLastDate));
+                i->second.generation = generation;
+            }
+            return i->second.schedule;
+        }
+
+        boost::shared_ptr<const Schedule> s(
+                   new Schedule(effectiveDate, terminationDate, tenor,
+                                calendar, convention,
+                                terminationDateConvention, rule,
+                                endOfMonth, firstDate, nextToLastDate));
+        if (capacity_ > 0) {
+            if (data_.size() >= capacity_)
+                trim(capacity_-1);
+            Entry e;
+            e.schedule = s;
+            e.generation = generation;
+            e.use = usage_.insert(usage_.begin(), k);
+            data_.insert(std::make_pair(k, e));
+        }
+        return s;
+    }
+
+    void ScheduleCache::trim(Size n) {
+        while (data_.size() > n) {
+            data_.erase(usage_.back());
+            usage_.pop_back();
+        }
+    }
+
+    Size ScheduleCache::size() const {
+        return data_.size();
+    }
+
+    Size ScheduleCache::capacity() const {
+        return capacity_;
+    }
+
+    void ScheduleCache::setCapacity(Size n) {
+        capacity_ = n;
+        trim(capacity_);
+    }
+
+    void ScheduleCache::clear() {
+        data_.clear();
+        usage_.clear();
+    }
+
+}
@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief global repository of generated schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/time/schedule.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <boost/shared_ptr.hpp>
+#include <list>
+#include <map>
+
+namespace QuantLib {
+
+    //! global repository of generated schedules
+    /*! Schedules are stored together with the parameters they were
+        generated from, so that instruments built on the same dates
+        and conventions can share a single immutable instance instead
+        of generating it again.
+
+        Calendars are identified by their name, as in the comparison
+        between calendars.  A stored schedule is generated again when
+        the holidays of its calendar are changed; when the number of
+        stored schedules reaches the capacity of the cache, the least
+        recently used one is discarded to make room for a new one.
+        The schedules already returned are not affected.
+
+        \note schedules with a null effective date are not stored,
+              since in that case their dates depend on the evaluation
+              date.
+    */
+    class ScheduleCache : public Singleton<ScheduleCache> {
+        friend class Singleton<ScheduleCache>;
+      private:
+        ScheduleCache() : capacity_(10000) {}
+      public:
+        //! returns the schedule with the given parameters
+        /*! The schedule is generated and stored if it was not
+            already available.
+        */
+        boost::shared_ptr<const Schedule> schedule(
+                          const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate = Date(),
+                          const Date& nextToLastDate = Date());
+        //! number of stored schedules
+        Size size() const;
+        //! maximum number of stored schedules
+        Size capacity() const;
+        /*! Sets the maximum number of stored schedules; if needed,
+            the least recently used ones are discarded.
+        */
+        void setCapacity(Size n);
+        //! clears all stored schedules
+        void clear();
+      private:
+        struct Key {
+            Date effectiveDate, terminationDate;
+            Period tenor;
+            std::string calendar;
+            BusinessDayConvention convention, terminationDateConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            Date firstDate, nextToLastDate;
+            bool operator<(const Key&) const;
+        };
+        void trim(Size n);
+        // keys ordered by use, the most recent first
+        typedef std::list<Key> usage_list;
+        struct Entry {
+            boost::shared_ptr<const Schedule> schedule;
+            // generation of the calendar used for the schedule
+            unsigned long generation;
+            usage_list::iterator use;
+        };
+        typedef std::map<Key, Entry> schedule_map;
+        schedule_map data_;
+        usage_list usage_;
+        Size capacity_;
+    };
+
+}
+
+
+#endif
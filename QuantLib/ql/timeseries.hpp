@@ -63,8 +63,7 @@ namespace QuantLib {
         template <class DateIterator, class ValueIterator>
         TimeSeries(DateIterator dBegin, DateIterator dEnd,
                    ValueIterator vBegin) {
-            while (dBegin != dEnd)
-                values_[*(dBegin++)] = *(vBegin++);
+            insert(dBegin, dEnd, vBegin);
         }
         /*! This constructor initializes the history with a set of
             values. Such values are assigned to a corresponding number
@@ -93,8 +92,9 @@ namespace QuantLib {
         //@{
         //! returns the (possibly null) datum corresponding to the given date
         T operator[](const Date& d) const {
-            if (values_.find(d) != values_.end())
-                return values_[d];
+            typename Container::const_iterator i = values_.find(d);
+            if (i != values_.end())
+                return i->second;
             else
                 return Null<T>();
         }
@@ -226,6 +226,15 @@ namespace QuantLib {
         std::vector<Date> dates() const;
         //! returns the historical data
         std::vector<T> values() const;
+        //! stores the data at the given dates
+        /*! Existing data at the same dates are overwritten.
+            Insertion takes constant time per datum when the dates
+            are sorted and follow the ones already stored, as when
+            appending new fixings to a history.
+        */
+        template <class DateIterator, class ValueIterator>
+        void insert(DateIterator dBegin, DateIterator dEnd,
+                    ValueIterator vBegin);
         //@}
 
       private:
@@ -294,6 +303,21 @@ namespace QuantLib {
         return v;
     }
 
+    template <class T, class C>
+    template <class DateIterator, class ValueIterator>
+    void TimeSeries<T,C>::insert(DateIterator dBegin, DateIterator dEnd,
+                                 ValueIterator vBegin) {
+        // the hint makes the insertion of sorted dates linear
+        typename C::iterator hint = values_.end();
+        while (dBegin != dEnd) {
+            T value = *(vBegin++);
+            hint = values_.insert(hint,
+                                  container_value_type(*(dBegin++), value));
+            hint->second = value;
+            ++hint;
+        }
+    }
+
     template <class T, class C>
     std::vector<T> TimeSeries<T,C>::values() const {
         std::vector<T> v;
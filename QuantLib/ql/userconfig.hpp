@@ -77,4 +77,12 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this to have singletons return a different instance for each
+   thread, so that different evaluation dates and fixings can be used
+   concurrently. It requires linking with Boost.Thread and cannot be
+   used together with QL_ENABLE_SESSIONS.*/
+#ifndef QL_ENABLE_THREAD_LOCAL_SESSIONS
+//#   define QL_ENABLE_THREAD_LOCAL_SESSIONS
+#endif
+
 #endif
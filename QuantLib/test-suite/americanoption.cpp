@@ -557,6 +557,61 @@ void AmericanOptionTest::testFdShoutGreeks() {
     testFdGreeks<FDShoutEngine<CrankNicolson> >();
 }
 
+void AmericanOptionTest::testFdImpliedVol() {
+    BOOST_TEST_MESSAGE("Testing finite-differences American option "
+                       "implied volatility...");
+
+    Date today = Date::todaysDate();
+    DayCounter dc = Actual360();
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.0));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+    boost::shared_ptr<PricingEngine> engine(
+                     new FDAmericanEngine<CrankNicolson>(stochProcess));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 80.0, 100.0, 120.0 };
+    Volatility vols[] = { 0.15, 0.30, 0.50 };
+    Date exDate = today + 360;
+    boost::shared_ptr<Exercise> exercise(new AmericanExercise(today, exDate));
+
+    Real accuracy = 1.0e-4;
+    Real tolerance = 1.0e-3;
+
+    for (Size i=0; i<LENGTH(types); i++) {
+        for (Size j=0; j<LENGTH(strikes); j++) {
+            boost::shared_ptr<StrikedTypePayoff> payoff(new
+                PlainVanillaPayoff(types[i], strikes[j]));
+            VanillaOption option(payoff, exercise);
+            option.setPricingEngine(engine);
+
+            for (Size k=0; k<LENGTH(vols); k++) {
+                vol->setValue(vols[k]);
+                Real value = option.NPV();
+                if (value - (*payoff)(spot->value()) < 1.0e-2) {
+                    // no time value left---the price is flat in the
+                    // volatility and it's pointless to solve
+                    continue;
+                }
+                Volatility implied =
+                    option.impliedVolatility(value, stochProcess, accuracy);
+                if (std::fabs(implied-vols[k]) > tolerance)
+                    REPORT_FAILURE("implied volatility", payoff, exercise,
+                                   spot->value(), 0.03, 0.06, today, vols[k], vols[k], implied,
+                                   std::fabs(implied-vols[k]), tolerance);
+            }
+        }
+    }
+}
+
 test_suite* AmericanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("American option tests");
     suite->add(
@@ -571,6 +626,7 @@ test_suite* AmericanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdImpliedVol));
     return suite;
 }
 
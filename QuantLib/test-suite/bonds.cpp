@@ -42,6 +42,7 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1013,6 +1014,164 @@ void BondTest::testBrazilianCached() {
 
 
 
+void BondTest::testBatchAnalytics() {
+
+    BOOST_TEST_MESSAGE("Testing batch bond analytics...");
+
+    CommonVars vars;
+
+    Real accuracy = 1.0e-12;
+    Size maxEvaluations = 100;
+
+    shared_ptr<YieldTermStructure> discountCurve =
+        flatRate(vars.today, 0.03, Actual360());
+
+    Integer issueMonths[] = { -18, -6, 0, 12 };
+    Integer lengths[] = { 3, 10, 20 };
+    Natural settlementDays = 3;
+    Real coupons[] = { 0.02, 0.08 };
+    Frequency frequency = Semiannual;
+    DayCounter bondDayCount = ActualActual(ActualActual::ISMA);
+    Real redemption = 100.0;
+
+    std::vector<shared_ptr<Bond> > bonds;
+    for (Size i=0; i<LENGTH(issueMonths); i++) {
+        for (Size j=0; j<LENGTH(lengths); j++) {
+            Date issue = vars.calendar.advance(vars.today,
+                                               issueMonths[i], Months);
+            Date maturity = vars.calendar.advance(issue, lengths[j], Years);
+            Schedule sch(issue, maturity, Period(frequency), vars.calendar,
+                         Unadjusted, Unadjusted,
+                         DateGeneration::Backward, false);
+            for (Size k=0; k<LENGTH(coupons); k++) {
+                bonds.push_back(shared_ptr<Bond>(
+                    new FixedRateBond(settlementDays, vars.faceAmount, sch,
+                                      std::vector<Rate>(1, coupons[k]),
+                                      bondDayCount, ModifiedFollowing,
+                                      redemption, issue)));
+            }
+            bonds.push_back(shared_ptr<Bond>(
+                new ZeroCouponBond(settlementDays, vars.calendar,
+                                   vars.faceAmount, maturity,
+                                   ModifiedFollowing, redemption, issue)));
+        }
+    }
+
+    struct test_case {
+        Compounding compounding;
+        Frequency frequency;
+        Duration::Type type;
+    };
+    test_case cases[] = {
+        { Compounded, Semiannual, Duration::Modified },
+        { Compounded, Annual, Duration::Macaulay },
+        { Continuous, NoFrequency, Duration::Simple },
+        { SimpleThenCompounded, Semiannual, Duration::Modified }
+    };
+    Rate yields[] = { 0.01, 0.04, 0.09 };
+
+    for (Size n=0; n<LENGTH(cases); n++) {
+        Compounding comp = cases[n].compounding;
+        Frequency freq = cases[n].frequency;
+        std::vector<Real> prices(bonds.size());
+        for (Size i=0; i<bonds.size(); i++)
+            prices[i] = BondFunctions::cleanPrice(*bonds[i],
+                                                  yields[i%LENGTH(yields)],
+                                                  bondDayCount, comp, freq);
+
+        std::vector<BondFunctions::Analytics> results =
+            BondFunctions::analytics(bonds, prices, bondDayCount, comp, freq,
+                                     discountCurve, cases[n].type, Date(),
+                                     accuracy, maxEvaluations);
+
+        for (Size i=0; i<bonds.size(); i++) {
+            const Bond& bond = *bonds[i];
+            const BondFunctions::Analytics& a = results[i];
+            InterestRate y(a.yield, bondDayCount, comp, freq);
+            Real expected[] = {
+                BondFunctions::yield(bond, prices[i], bondDayCount,
+                                     comp, freq, Date(),
+                                     accuracy, maxEvaluations),
+                BondFunctions::duration(bond, y, cases[n].type),
+                BondFunctions::convexity(bond, y),
+                BondFunctions::basisPointValue(bond, y),
+                BondFunctions::zSpread(bond, prices[i], discountCurve,
+                                       bondDayCount, comp, freq, Date(),
+                                       accuracy, maxEvaluations)
+            };
+            Real calculated[] = {
+                a.yield, a.duration, a.convexity,
+                a.basisPointValue, a.zSpread
+            };
+            Real tolerances[] = { 1.0e-10, 1.0e-10, 1.0e-9, 1.0e-6, 1.0e-10 };
+            std::string labels[] = {
+                "yield", "duration", "convexity",
+                "basis-point value", "z-spread"
+            };
+            for (Size j=0; j<LENGTH(labels); j++) {
+                if (std::fabs(calculated[j] - expected[j]) > tolerances[j])
+                    BOOST_FAIL("wrong batch " << labels[j] << ":"
+                               << "\n    bond:        " << i
+                               << "\n    maturity:    "
+                               << bond.maturityDate()
+                               << "\n    case:        " << n
+                               << QL_SCIENTIFIC << std::setprecision(15)
+                               << "\n    calculated:  " << calculated[j]
+                               << "\n    expected:    " << expected[j]);
+            }
+        }
+    }
+
+    // a failure for a bond doesn't prevent the calculation of the
+    // others, and the curve is extrapolated beyond its last date
+    Date expiredIssue = vars.calendar.advance(vars.today, -5, Years);
+    std::vector<shared_ptr<Bond> > batch;
+    batch.push_back(shared_ptr<Bond>(
+        new ZeroCouponBond(settlementDays, vars.calendar, vars.faceAmount,
+                           vars.calendar.advance(expiredIssue, 3, Years),
+                           ModifiedFollowing, redemption, expiredIssue)));
+    batch.push_back(bonds.back());
+
+    std::vector<Date> curveDates;
+    curveDates.push_back(vars.today);
+    curveDates.push_back(vars.today + 5*Years);
+    std::vector<Rate> curveRates;
+    curveRates.push_back(0.03);
+    curveRates.push_back(0.035);
+    shared_ptr<YieldTermStructure> shortCurve(
+                         new ZeroCurve(curveDates, curveRates, Actual360()));
+
+    std::vector<Real> prices(batch.size(), 100.0);
+    prices[1] = BondFunctions::cleanPrice(*batch[1], 0.04, bondDayCount,
+                                          Compounded, Semiannual);
+    std::vector<BondFunctions::Analytics> results =
+        BondFunctions::analytics(batch, prices, bondDayCount,
+                                 Compounded, Semiannual, shortCurve,
+                                 Duration::Modified, Date(),
+                                 accuracy, maxEvaluations);
+
+    if (results[0].error.empty() || results[0].yield != Null<Rate>()
+        || results[0].zSpread != Null<Spread>())
+        BOOST_FAIL("batch results returned for expired bond:"
+                   << "\n    yield:    " << results[0].yield
+                   << "\n    z-spread: " << results[0].zSpread);
+    if (!results[1].error.empty())
+        BOOST_FAIL("batch analytics failed for bond beyond curve:"
+                   << "\n    error: " << results[1].error);
+
+    shortCurve->enableExtrapolation();
+    Spread expected = BondFunctions::zSpread(*batch[1], prices[1], shortCurve,
+                                             bondDayCount, Compounded,
+                                             Semiannual, Date(),
+                                             accuracy, maxEvaluations);
+    if (std::fabs(results[1].zSpread - expected) > 1.0e-10)
+        BOOST_FAIL("wrong batch z-spread for bond beyond curve:"
+                   << QL_SCIENTIFIC << std::setprecision(15)
+                   << "\n    calculated:  " << results[1].zSpread
+                   << "\n    expected:    " << expected);
+}
+
+
 test_suite* BondTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bond tests");
 
@@ -1025,6 +1184,7 @@ test_suite* BondTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testCachedFixed));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testCachedFloating));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testBrazilianCached));
+    suite->add(QUANTLIB_TEST_CASE(&BondTest::testBatchAnalytics));
     return suite;
 }
 
@@ -36,6 +36,7 @@ class BondTest {
     static void testCachedFixed();
     static void testCachedFloating();
     static void testBrazilianCached();
+    static void testBatchAnalytics();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -1108,6 +1108,164 @@ void CalendarTest::testBespokeCalendars() {
         BOOST_ERROR(testDate4 << " (marked as holiday) not detected");
 
 }
+namespace {
+
+    void checkCompiledCalendar(const Calendar& calendar,
+                               const Date& firstDate,
+                               const Date& endDate) {
+        Calendar compiled = calendar;
+        compiled.compile();
+
+        if (!compiled.isCompiled() || calendar.isCompiled())
+            BOOST_FAIL("compilation not limited to the given instance");
+
+        Integer n[] = { -30, -5, -1, 1, 2, 7, 30 };
+        for (Date d = firstDate; d < endDate; d++) {
+            if (compiled.isBusinessDay(d) != calendar.isBusinessDay(d))
+                BOOST_FAIL("At date " << d << ":\n"
+                           << "    inconsistency between compiled calendar "
+                           << calendar.name() << " and its rules");
+            for (Size i=0; i<LENGTH(n); ++i) {
+                Date expected = calendar.advance(d, n[i], Days);
+                Date calculated = compiled.advance(d, n[i], Days);
+                if (calculated != expected)
+                    BOOST_FAIL("advancing " << d << " by " << n[i]
+                               << " days in " << calendar.name() << ":\n"
+                               << "    calculated: " << calculated << "\n"
+                               << "    expected:   " << expected);
+            }
+            Date to = d + 45;
+            for (Size k=0; k<4; ++k) {
+                bool includeFirst = (k/2 == 0), includeLast = (k%2 == 0);
+                BigInteger expected =
+                    calendar.businessDaysBetween(d, to, includeFirst,
+                                                 includeLast);
+                BigInteger calculated =
+                    compiled.businessDaysBetween(d, to, includeFirst,
+                                                 includeLast);
+                if (calculated != expected)
+                    BOOST_FAIL("business days between " << d << " and "
+                               << to << " in " << calendar.name() << ":\n"
+                               << "    calculated: " << calculated << "\n"
+                               << "    expected:   " << expected);
+                expected = calendar.businessDaysBetween(to, d, includeFirst,
+                                                        includeLast);
+                calculated = compiled.businessDaysBetween(to, d, includeFirst,
+                                                          includeLast);
+                if (calculated != expected)
+                    BOOST_FAIL("business days between " << to << " and "
+                               << d << " in " << calendar.name() << ":\n"
+                               << "    calculated: " << calculated << "\n"
+                               << "    expected:   " << expected);
+            }
+        }
+    }
+
+}
+
+void CalendarTest::testCompiledCalendars() {
+
+    BOOST_TEST_MESSAGE("Testing compiled calendars...");
+
+    Date firstDate(1, January, 2010), endDate(1, January, 2014);
+
+    checkCompiledCalendar(TARGET(), firstDate, endDate);
+    checkCompiledCalendar(UnitedKingdom(), firstDate, endDate);
+    checkCompiledCalendar(UnitedStates(UnitedStates::NYSE),
+                          firstDate, endDate);
+    checkCompiledCalendar(Japan(), firstDate, endDate);
+    checkCompiledCalendar(JointCalendar(TARGET(), UnitedKingdom(),
+                                        JoinHolidays),
+                          firstDate, endDate);
+
+    // the range boundaries
+    checkCompiledCalendar(TARGET(), Date::minDate() + 60,
+                          Date::minDate() + 120);
+    checkCompiledCalendar(TARGET(), Date::maxDate() - 120,
+                          Date::maxDate() - 60);
+
+    // the tables must follow changes in the holidays
+    BespokeCalendar bespoke("compiled");
+    Calendar compiled = bespoke;
+    compiled.compile();
+    Date d(15, March, 2012);
+    if (!compiled.isBusinessDay(d))
+        BOOST_FAIL(d << " not a business day before edits");
+    bespoke.addWeekend(Thursday);
+    if (compiled.isBusinessDay(d))
+        BOOST_FAIL(d << " still a business day after adding weekend");
+    bespoke.removeHoliday(d);
+    if (!compiled.isBusinessDay(d))
+        BOOST_FAIL(d << " not a business day after removing holiday");
+    compiled.addHoliday(d);
+    if (compiled.isBusinessDay(d) || bespoke.isBusinessDay(d))
+        BOOST_FAIL(d << " still a business day after adding holiday");
+    checkCompiledCalendar(bespoke, firstDate, endDate);
+
+    // ...and only those of the modified calendar are outdated
+    Calendar target = TARGET();
+    unsigned long targetGeneration = target.generation(),
+                  bespokeGeneration = bespoke.generation();
+    bespoke.removeHoliday(d);
+    if (bespoke.generation() == bespokeGeneration)
+        BOOST_FAIL("holiday change not recorded");
+    if (target.generation() != targetGeneration)
+        BOOST_FAIL("holiday change in " << bespoke.name()
+                   << " recorded for " << target.name());
+}
+
+void CalendarTest::testJointCalendarTables() {
+
+    BOOST_TEST_MESSAGE("Testing tables of joint calendars...");
+
+    Calendar c1 = TARGET(), c2 = UnitedKingdom();
+    BespokeCalendar c3("joint");
+
+    Calendar h1 = JointCalendar(c1, c2, c3, JoinHolidays),
+             h2 = JointCalendar(c1, c2, c3, JoinHolidays),
+             b = JointCalendar(c1, c2, c3, JoinBusinessDays);
+
+    if (h1.isCompiled() || h2.isCompiled() || b.isCompiled())
+        BOOST_FAIL("joint calendars compiled without being asked to");
+    h1.compile();
+    h2.compile();
+    b.compile();
+
+    // the whole range, including the boundaries
+    for (Date d = Date::minDate(); d < Date::maxDate(); d++) {
+        bool b1 = c1.isBusinessDay(d),
+             b2 = c2.isBusinessDay(d),
+             b3 = c3.isBusinessDay(d);
+        if ((b1 && b2 && b3) != h1.isBusinessDay(d)
+            || (b1 || b2 || b3) != b.isBusinessDay(d))
+            BOOST_FAIL("At date " << d << ":\n"
+                       << "    inconsistency between joint calendars "
+                       << "and their components");
+    }
+
+    // changes in the components are picked up...
+    Date d(15, March, 2012);
+    c3.addWeekend(Thursday);
+    if (h1.isBusinessDay(d) || !b.isBusinessDay(d))
+        BOOST_FAIL("weekend added to component not picked up");
+    c2.addHoliday(d+1);
+    if (h1.isBusinessDay(d+1) || h2.isBusinessDay(d+1))
+        BOOST_FAIL("holiday added to component not picked up");
+    c2.removeHoliday(d+1);
+    if (!h1.isBusinessDay(d+1))
+        BOOST_FAIL("holiday removed from component not picked up");
+
+    // ...while changes in a joint calendar don't affect the others
+    h1.addHoliday(d-1);
+    if (h1.isBusinessDay(d-1))
+        BOOST_FAIL("holiday added to joint calendar not picked up");
+    if (!h2.isBusinessDay(d-1))
+        BOOST_FAIL("holiday added to joint calendar affects another one");
+    if (h1.advance(d-2, 1, Days) != d+1 || h2.advance(d-2, 1, Days) != d-1)
+        BOOST_FAIL("wrong advance in joint calendars with edited holidays");
+    h1.removeHoliday(d-1);
+}
+
 
 test_suite* CalendarTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
@@ -1141,6 +1299,8 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testCompiledCalendars));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testJointCalendarTables));
 
     return suite;
 }
@@ -57,6 +57,8 @@ class CalendarTest {
 
     static void testEndOfMonth();
     static void testBusinessDaysBetween();
+    static void testCompiledCalendars();
+    static void testJointCalendarTables();
 
     static boost::unit_test_framework::test_suite* suite();
 };
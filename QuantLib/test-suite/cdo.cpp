@@ -21,6 +21,7 @@
 #include "utilities.hpp"
 #include <ql/experimental/credit/cdo.hpp>
 #include <ql/experimental/credit/syntheticcdoengines.hpp>
+#include <ql/experimental/credit/latticelossmodel.hpp>
 #include <ql/experimental/credit/onefactorgaussiancopula.hpp>
 #include <ql/experimental/credit/onefactorstudentcopula.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -163,6 +164,11 @@ void CdoTest::testHW() {
                           new MonteCarloCDOEngine2(rdm, 10000));
     boost::shared_ptr<PricingEngine> engine7(
                           new GLHPMidPointCDOEngine(hCopula));
+    // the loss distribution is shared among the tranches
+    boost::shared_ptr<LatticeLossModel> latticeModel(
+                          new LatticeLossModel(hCopula));
+    boost::shared_ptr<PricingEngine> engine8(
+                          new LatticeMidPointCDOEngine(latticeModel));
 
     QL_REQUIRE (LENGTH(hwAttachment) == LENGTH(hwDetachment),
                 "data length does not match");
@@ -252,6 +258,280 @@ void CdoTest::testHW() {
             cdoe.setPricingEngine(engine7);
             check(i, j, "Gaussian LHP", cdoe.fairPremium() * 1e4,
                   hwData7[i].trancheSpread[j], 10, 0.5);
+
+            cdoe.setPricingEngine(engine8);
+            check(i, j, "LatticeMidPointEngine", cdoe.fairPremium() * 1e4,
+                  hwData7[i].trancheSpread[j], 1, 0.04);
+        }
+    }
+}
+
+void CdoTest::testPrecomputedProbabilities() {
+
+    BOOST_TEST_MESSAGE ("Testing precomputed basket probabilities "
+                        "and copula thresholds...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    boost::shared_ptr<SimpleQuote> lambda(new SimpleQuote(0.01));
+    boost::shared_ptr<DefaultProbabilityTermStructure> curve(
+                           new FlatHazardRate(asofDate,
+                                              Handle<Quote>(lambda),
+                                              ActualActual()));
+    DefaultProbKey key = NorthAmericaCorpDefaultKey(EURCurrency(),
+                                                    SeniorSec);
+    vector<pair<DefaultProbKey,
+           Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+                   key, Handle<DefaultProbabilityTermStructure>(curve)));
+
+    Size poolSize = 10;
+    boost::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities));
+    }
+
+    Basket basket(names, vector<Real>(poolSize, 100.0), pool,
+                  vector<DefaultProbKey>(poolSize, key),
+                  vector<boost::shared_ptr<RecoveryRateModel> >(
+                      poolSize,
+                      boost::shared_ptr<RecoveryRateModel>(
+                                  new ConstantRecoveryModel(0.4, SeniorSec))),
+                  0.03, 0.06);
+
+    Schedule schedule = MakeSchedule().from(Date(1, September, 2006))
+                                      .to(Date(1, September, 2011))
+                                      .withTenor(Period(3, Months))
+                                      .withCalendar(TARGET());
+    basket.addProbabilityDates(schedule.dates());
+
+    Real tolerance = 1.0e-15;
+    for (Size k=0; k<2; ++k) {
+        // the second time, the grid must be refreshed
+        if (k == 1)
+            lambda->setValue(0.02);
+        const Matrix& grid = basket.probabilityGrid();
+        for (Size i=0; i<schedule.size(); ++i) {
+            Real expected = curve->defaultProbability(schedule.date(i));
+            vector<Real> p = basket.probabilities(schedule.date(i));
+            for (Size j=0; j<poolSize; ++j) {
+                if (std::fabs(grid[i][j] - expected) > tolerance
+                    || std::fabs(p[j] - expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce default probability"
+                                << "\n    date:       " << schedule.date(i)
+                                << "\n    hazard:     " << lambda->value()
+                                << "\n    grid:       " << grid[i][j]
+                                << "\n    basket:     " << p[j]
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+
+    boost::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.3));
+    OneFactorStudentCopula copula(Handle<Quote>(correlation), 5, 5);
+    for (Size k=0; k<2; ++k) {
+        // the second time, the cached thresholds must be discarded
+        if (k == 1)
+            correlation->setValue(0.5);
+        vector<Real> p = basket.probabilities(schedule.dates().back());
+        p.push_back(0.0);
+        vector<Real> y = copula.thresholds(p);
+        vector<Real> conditional;
+        for (Real m = -3.0; m <= 3.0; m += 0.5) {
+            copula.conditionalProbabilityFromThresholds(y, m, conditional);
+            for (Size j=0; j<p.size(); ++j) {
+                Real expected = copula.conditionalProbability(p[j], m);
+                if (std::fabs(conditional[j] - expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce conditional probability"
+                                << "\n    correlation: " << correlation->value()
+                                << "\n    probability: " << p[j]
+                                << "\n    factor:      " << m
+                                << "\n    calculated:  " << conditional[j]
+                                << "\n    expected:    " << expected);
+            }
+        }
+        Real expected = copula.inverseCumulativeY(p.front());
+        if (std::fabs(y.front() - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce default threshold"
+                        << "\n    correlation: " << correlation->value()
+                        << "\n    calculated:  " << y.front()
+                        << "\n    expected:    " << expected);
+    }
+}
+
+void CdoTest::testInhomogeneousLatticeLoss() {
+
+    BOOST_TEST_MESSAGE ("Testing lattice loss model "
+                        "on an inhomogeneous pool...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    boost::shared_ptr<DefaultProbabilityTermStructure> curve(
+                 new FlatHazardRate(asofDate,
+                                    Handle<Quote>(boost::shared_ptr<Quote>(
+                                                   new SimpleQuote(0.05))),
+                                    ActualActual()));
+    DefaultProbKey key = NorthAmericaCorpDefaultKey(EURCurrency(),
+                                                    SeniorSec);
+    vector<pair<DefaultProbKey,
+           Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+                   key, Handle<DefaultProbabilityTermStructure>(curve)));
+
+    // LGDs of 90, 60, 63 and 80 on equal notionals
+    Real recoveries[] = { 0.1, 0.4, 0.37, 0.2 };
+    Size poolSize = LENGTH(recoveries);
+    boost::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    vector<boost::shared_ptr<RecoveryRateModel> > recoveryModels;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities));
+        recoveryModels.push_back(boost::shared_ptr<RecoveryRateModel>(
+                         new ConstantRecoveryModel(recoveries[i], SeniorSec)));
+    }
+    Basket basket(names, vector<Real>(poolSize, 100.0), pool,
+                  vector<DefaultProbKey>(poolSize, key), recoveryModels,
+                  0.1, 0.5);
+
+    // with null correlation the names default independently, and
+    // the expected tranche loss can be summed over all scenarios
+    Date date = asofDate + 5*Years;
+    vector<Real> p = basket.probabilities(date);
+    const vector<Real>& lgds = basket.LGDs();
+    Real a = basket.attachmentAmount(), d = basket.detachmentAmount();
+    Real expected = 0.0, expectedPoolLoss = 0.0;
+    for (Size s=0; s < (Size(1) << poolSize); ++s) {
+        Real probability = 1.0, loss = 0.0;
+        for (Size i=0; i<poolSize; ++i) {
+            if (s & (Size(1) << i)) {
+                probability *= p[i];
+                loss += lgds[i];
+            } else {
+                probability *= 1.0 - p[i];
+            }
+        }
+        expected += probability * std::min(std::max(loss - a, 0.0), d - a);
+        expectedPoolLoss += probability * loss;
+    }
+
+    Real accuracy = 0.01;
+    Handle<OneFactorCopula> copula(boost::shared_ptr<OneFactorCopula>(
+                            new OneFactorGaussianCopula(Handle<Quote>(
+                                boost::shared_ptr<Quote>(
+                                                  new SimpleQuote(0.0))))));
+    LatticeLossModel model(copula, Null<Size>(), 20, accuracy);
+
+    Real unit = model.lossUnit(basket);
+    for (Size i=0; i<poolSize; ++i) {
+        Real rounded = std::floor(lgds[i]/unit + 0.5) * unit;
+        if (std::fabs(rounded - lgds[i]) > accuracy * lgds[i])
+            BOOST_ERROR("LGD rounded beyond the required accuracy"
+                        << "\n    LGD:       " << lgds[i]
+                        << "\n    loss unit: " << unit
+                        << "\n    rounded:   " << rounded);
+    }
+
+    // each loss is off by no more than the accuracy
+    Real calculated = model.expectedTrancheLoss(basket, date);
+    if (std::fabs(calculated - expected) > accuracy * expectedPoolLoss)
+        BOOST_ERROR("failed to reproduce expected tranche loss"
+                    << "\n    loss unit:  " << unit
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
+void CdoTest::testSeasonedTranche() {
+
+    BOOST_TEST_MESSAGE ("Testing seasoned synthetic CDO tranche...");
+
+    SavedSettings backup;
+
+    // the tranche started before the evaluation date
+    Date asofDate = Date(15, June, 2007);
+    Settings::instance().evaluationDate() = asofDate;
+    Schedule schedule = MakeSchedule().from(Date(1, September, 2006))
+                                      .to(Date(1, September, 2011))
+                                      .withTenor(Period(3, Months))
+                                      .withCalendar(TARGET());
+
+    boost::shared_ptr<SimpleQuote> hazardRate(new SimpleQuote(0.01));
+    boost::shared_ptr<DefaultProbabilityTermStructure> curve(
+                 new FlatHazardRate(asofDate, Handle<Quote>(hazardRate),
+                                    ActualActual()));
+    DefaultProbKey key = NorthAmericaCorpDefaultKey(EURCurrency(),
+                                                    SeniorSec);
+    vector<pair<DefaultProbKey,
+           Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+                   key, Handle<DefaultProbabilityTermStructure>(curve)));
+
+    Size poolSize = 10;
+    boost::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities));
+    }
+    vector<boost::shared_ptr<RecoveryRateModel> > recoveryModels(
+                      poolSize,
+                      boost::shared_ptr<RecoveryRateModel>(
+                                  new ConstantRecoveryModel(0.4, SeniorSec)));
+    boost::shared_ptr<Basket> basket(
+                          new Basket(names, vector<Real>(poolSize, 100.0),
+                                     pool, vector<DefaultProbKey>(poolSize, key),
+                                     recoveryModels, 0.03, 0.06));
+    // no probability grid for the reference basket
+    Basket referenceBasket(names, vector<Real>(poolSize, 100.0),
+                           pool, vector<DefaultProbKey>(poolSize, key),
+                           recoveryModels, 0.03, 0.06);
+
+    Handle<YieldTermStructure> yieldHandle(
+                            flatRate(asofDate, 0.05, Actual360()));
+    SyntheticCDO cdo(basket, Protection::Seller, schedule, 0.0, 0.02,
+                     Actual360(), Following, yieldHandle);
+
+    Handle<OneFactorCopula> copula(boost::shared_ptr<OneFactorCopula>(
+                            new OneFactorGaussianCopula(Handle<Quote>(
+                                boost::shared_ptr<Quote>(
+                                                  new SimpleQuote(0.3))))));
+    boost::shared_ptr<LatticeLossModel> model(new LatticeLossModel(copula));
+    cdo.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                   new LatticeMidPointCDOEngine(model)));
+
+    Real tolerance = 1.0e-12;
+    for (Size k=0; k<2; ++k) {
+        // the second time, the engine keeps the remaining basket and
+        // its grid, which must follow the changes in the curves
+        if (k == 1) {
+            hazardRate->setValue(0.02);
+            cdo.recalculate();
+        }
+        vector<Real> losses = cdo.expectedTrancheLoss();
+        for (Size i=0; i<schedule.size(); ++i) {
+            Date d = schedule.date(i);
+            Real expected = d <= asofDate ? 0.0 :
+                model->expectedTrancheLoss(referenceBasket, d);
+            if (std::fabs(losses[i] - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce expected tranche loss"
+                            << "\n    hazard:     " << hazardRate->value()
+                            << "\n    date:       " << d
+                            << "\n    calculated: " << losses[i]
+                            << "\n    expected:   " << expected);
         }
     }
 }
@@ -260,5 +540,8 @@ void CdoTest::testHW() {
 test_suite* CdoTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     suite->add(QUANTLIB_TEST_CASE(&CdoTest::testHW));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testPrecomputedProbabilities));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testInhomogeneousLatticeLoss));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testSeasonedTranche));
     return suite;
 }
@@ -28,6 +28,9 @@
 class CdoTest {
   public:
     static void testHW();
+    static void testPrecomputedProbabilities();
+    static void testInhomogeneousLatticeLoss();
+    static void testSeasonedTranche();
     static boost::unit_test_framework::test_suite* suite();
 };
 
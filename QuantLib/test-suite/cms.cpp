@@ -477,10 +477,208 @@ void CmsTest::testParity() {
     }
 }
 
+void CmsTest::testFixedNodeQuadrature() {
+
+    BOOST_TEST_MESSAGE("Testing fixed-node quadrature in numeric Hagan pricer...");
+
+    CommonVars vars;
+
+    std::vector<Handle<SwaptionVolatilityStructure> > swaptionVols;
+    swaptionVols.push_back(vars.atmVol);
+    swaptionVols.push_back(vars.SabrVolCube1);
+    swaptionVols.push_back(vars.SabrVolCube2);
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+    Date startDate = vars.termStructure->referenceDate() + 20*Years;
+    Date paymentDate = startDate + 1*Years;
+    Date endDate = paymentDate;
+    Real nominal = 1.0;
+    Real gearing = 1.0;
+    Spread spread = 0.0;
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+
+    for (Rate strike = .02; strike<.12; strike+=0.05) {
+        CappedFlooredCmsCoupon caplet(paymentDate, nominal,
+                                      startDate, endDate,
+                                      swapIndex->fixingDays(),
+                                      swapIndex,
+                                      gearing, spread,
+                                      strike, Null<Rate>(),
+                                      startDate, endDate,
+                                      vars.iborIndex->dayCounter());
+        CappedFlooredCmsCoupon floorlet(paymentDate, nominal,
+                                        startDate, endDate,
+                                        swapIndex->fixingDays(),
+                                        swapIndex,
+                                        gearing, spread,
+                                        Null<Rate>(), strike,
+                                        startDate, endDate,
+                                        vars.iborIndex->dayCounter());
+
+        for (Size i=0; i<swaptionVols.size(); ++i) {
+            for (Size j=0; j<vars.yieldCurveModels.size(); ++j) {
+                shared_ptr<CmsCouponPricer> adaptive(new
+                    NumericHaganPricer(swaptionVols[i],
+                                       vars.yieldCurveModels[j],
+                                       zeroMeanRev));
+                shared_ptr<CmsCouponPricer> fixed(new
+                    NumericHaganPricer(swaptionVols[i],
+                                       vars.yieldCurveModels[j],
+                                       zeroMeanRev,
+                                       0.0, 1.0, 1.0e-6, 128));
+
+                caplet.setPricer(adaptive);
+                floorlet.setPricer(adaptive);
+                Rate expectedCaplet = caplet.rate();
+                Rate expectedFloorlet = floorlet.rate();
+
+                caplet.setPricer(fixed);
+                floorlet.setPricer(fixed);
+                Rate calculatedCaplet = caplet.rate();
+                Rate calculatedFloorlet = floorlet.rate();
+
+                Real tol = 1.0e-6;
+                if (std::fabs(calculatedCaplet-expectedCaplet) > tol ||
+                    std::fabs(calculatedFloorlet-expectedFloorlet) > tol)
+                    BOOST_ERROR("\nstrike:              " << io::rate(strike) <<
+                                "\nYieldCurve Model:    " << vars.yieldCurveModels[j] <<
+                                "\nvolatility:          " << i <<
+                                "\nadaptive caplet:     " << io::rate(expectedCaplet) <<
+                                "\nfixed-node caplet:   " << io::rate(calculatedCaplet) <<
+                                "\nadaptive floorlet:   " << io::rate(expectedFloorlet) <<
+                                "\nfixed-node floorlet: " << io::rate(calculatedFloorlet) <<
+                                "\ntolerance:           " << io::rate(tol));
+            }
+        }
+    }
+}
+
+void CmsTest::testCachedFixingData() {
+
+    BOOST_TEST_MESSAGE("Testing cached fixing data in Hagan pricers...");
+
+    CommonVars vars;
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+    Date startDate = vars.termStructure->referenceDate() + 10*Years;
+    Date paymentDate = startDate + 1*Years;
+    Date endDate = paymentDate;
+    Date otherPaymentDate = paymentDate + 6*Months;
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+
+    // coupons sharing fixing date and index
+    CmsCoupon coupon1(paymentDate, 1.0, startDate, endDate,
+                      swapIndex->fixingDays(), swapIndex);
+    CmsCoupon coupon2(otherPaymentDate, 1.0, startDate, endDate,
+                      swapIndex->fixingDays(), swapIndex);
+
+    for (Size j=0; j<vars.yieldCurveModels.size(); ++j) {
+        std::vector<shared_ptr<CmsCouponPricer> > pricers(2);
+        pricers[0] = vars.numericalPricers[j];
+        pricers[1] = vars.analyticPricers[j];
+        for (Size k=0; k<pricers.size(); ++k) {
+            pricers[k]->setSwaptionVolatility(vars.atmVol);
+            coupon1.setPricer(pricers[k]);
+            coupon2.setPricer(pricers[k]);
+            Rate rate1 = coupon1.rate();
+            Rate rate2 = coupon2.rate();
+
+            // the cached data must be invalidated by curve changes
+            vars.termStructure.linkTo(
+                flatRate(vars.termStructure->referenceDate(), 0.04,
+                         Actual365Fixed()));
+            Rate shifted1 = coupon1.rate();
+            Rate shifted2 = coupon2.rate();
+
+            // ...and be consistent with a freshly-built pricer
+            shared_ptr<CmsCouponPricer> fresh;
+            if (k == 0)
+                fresh = shared_ptr<CmsCouponPricer>(new
+                    NumericHaganPricer(vars.atmVol,
+                                       vars.yieldCurveModels[j],
+                                       zeroMeanRev));
+            else
+                fresh = shared_ptr<CmsCouponPricer>(new
+                    AnalyticHaganPricer(vars.atmVol,
+                                        vars.yieldCurveModels[j],
+                                        zeroMeanRev));
+            coupon2.setPricer(fresh);
+            Rate expected2 = coupon2.rate();
+
+            vars.termStructure.linkTo(
+                flatRate(vars.termStructure->referenceDate(), 0.05,
+                         Actual365Fixed()));
+
+            if (std::fabs(shifted1-rate1) < 1.0e-4 ||
+                std::fabs(shifted2-rate2) < 1.0e-4)
+                BOOST_ERROR("cached data not updated after curve change"
+                            << "\nYieldCurve Model:   " << vars.yieldCurveModels[j]
+                            << "\ninitial rates:      " << io::rate(rate1)
+                            << ", " << io::rate(rate2)
+                            << "\nshifted rates:      " << io::rate(shifted1)
+                            << ", " << io::rate(shifted2));
+            if (std::fabs(shifted2-expected2) > 1.0e-12)
+                BOOST_ERROR("cached data inconsistent with fresh pricer"
+                            << "\nYieldCurve Model:   " << vars.yieldCurveModels[j]
+                            << "\ncached pricer:      " << io::rate(shifted2)
+                            << "\nfresh pricer:       " << io::rate(expected2));
+        }
+    }
+
+    // coupons sharing the payment date reuse the replication results
+    Real gearing = 2.0;
+    Spread spread = 0.001;
+    CmsCoupon coupon3(paymentDate, 1.0, startDate, endDate,
+                      swapIndex->fixingDays(), swapIndex,
+                      gearing, spread);
+    // ...and data for another index must not be mistaken for them
+    shared_ptr<SwapIndex> otherIndex(new
+        EuriborSwapIsdaFixA(5*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+    CmsCoupon coupon4(paymentDate, 1.0, startDate, endDate,
+                      otherIndex->fixingDays(), otherIndex);
+
+    for (Size j=0; j<vars.yieldCurveModels.size(); ++j) {
+        shared_ptr<CmsCouponPricer> pricer = vars.numericalPricers[j];
+        pricer->setSwaptionVolatility(vars.atmVol);
+        coupon1.setPricer(pricer);
+        coupon3.setPricer(pricer);
+        coupon4.setPricer(pricer);
+        Rate rate1 = coupon1.rate();
+        Rate rate3 = coupon3.rate();
+        Rate rate4 = coupon4.rate();
+
+        coupon4.setPricer(shared_ptr<CmsCouponPricer>(new
+            NumericHaganPricer(vars.atmVol, vars.yieldCurveModels[j],
+                               zeroMeanRev)));
+        Rate expected4 = coupon4.rate();
+
+        if (std::fabs(rate3-(gearing*rate1+spread)) > 1.0e-12)
+            BOOST_ERROR("inconsistent rate for coupon with same payment date"
+                        << "\nYieldCurve Model:   " << vars.yieldCurveModels[j]
+                        << "\nrate:               " << io::rate(rate3)
+                        << "\nexpected:           "
+                        << io::rate(gearing*rate1+spread));
+        if (std::fabs(rate4-expected4) > 1.0e-12)
+            BOOST_ERROR("cached data inconsistent with fresh pricer"
+                        << "\nYieldCurve Model:   " << vars.yieldCurveModels[j]
+                        << "\nswap index:         " << otherIndex->name()
+                        << "\ncached pricer:      " << io::rate(rate4)
+                        << "\nfresh pricer:       " << io::rate(expected4));
+    }
+}
+
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFixedNodeQuadrature));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCachedFixingData));
     return suite;
 }
@@ -30,6 +30,8 @@ class CmsTest {
     static void testFairRate();
     static void testParity();
     static void testCmsSwap();
+    static void testFixedNodeQuadrature();
+    static void testCachedFixingData();
     static boost::unit_test_framework::test_suite* suite();
 };
 
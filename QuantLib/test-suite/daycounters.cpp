@@ -24,6 +24,9 @@
 #include <ql/time/daycounters/one.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
 #include <ql/time/daycounters/business252.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/calendars/brazil.hpp>
 #include <ql/time/period.hpp>
 #include <iomanip>
@@ -287,6 +290,109 @@ void DayCounterTest::testBusiness252() {
     }
 }
 
+void DayCounterTest::testBatchYearFractions() {
+
+    BOOST_TEST_MESSAGE("Testing batch year fractions...");
+
+    DayCounter dayCounters[] = { Actual360(), Actual365Fixed(),
+                                 Thirty360(Thirty360::USA),
+                                 Thirty360(Thirty360::European),
+                                 Thirty360(Thirty360::Italian),
+                                 ActualActual(ActualActual::ISMA),
+                                 ActualActual(ActualActual::ISDA),
+                                 ActualActual(ActualActual::AFB),
+                                 SimpleDayCounter() };
+    Size n = LENGTH(dayCounters);
+
+    // regular and irregular periods, in both directions, and null
+    // and non-null reference periods
+    std::vector<Date> d1, d2, refStart, refEnd, noRefStart, noRefEnd;
+    Date start(28, December, 2011);
+    Integer lengths[] = { 0, 3, 31, 92, 181, 366, 800 };
+    Integer shifts[] = { -40, -1, 0, 1, 20 };
+    for (Date d = start; d < start + 2*Years; d += 5) {
+        for (Size i=0; i<LENGTH(lengths); ++i) {
+            for (Size j=0; j<LENGTH(shifts); ++j) {
+                Date end = d + lengths[i];
+                d1.push_back(d);
+                d2.push_back(end);
+                noRefStart.push_back(Date());
+                noRefEnd.push_back(Date());
+                refStart.push_back(d + shifts[j]);
+                refEnd.push_back(d + shifts[j] + 6*Months);
+                d1.push_back(end);
+                d2.push_back(d);
+                noRefStart.push_back(Date());
+                noRefEnd.push_back(Date());
+                refStart.push_back(d + shifts[j]);
+                refEnd.push_back(d + shifts[j] + 6*Months);
+            }
+        }
+    }
+
+    for (Size k=0; k<n; ++k) {
+        std::vector<Time> calculated =
+            dayCounters[k].yearFractions(d1, d2);
+        for (Size i=0; i<d1.size(); ++i) {
+            Time expected = dayCounters[k].yearFraction(d1[i], d2[i]);
+            if (calculated[i] != expected)
+                BOOST_FAIL(dayCounters[k] << " from " << d1[i]
+                           << " to " << d2[i] << ":\n"
+                           << std::setprecision(16)
+                           << "    calculated: " << calculated[i] << "\n"
+                           << "    expected:   " << expected);
+        }
+
+        calculated = dayCounters[k].yearFractions(d1, d2,
+                                                  noRefStart, noRefEnd);
+        for (Size i=0; i<d1.size(); ++i) {
+            Time expected = dayCounters[k].yearFraction(d1[i], d2[i]);
+            if (calculated[i] != expected)
+                BOOST_FAIL(dayCounters[k] << " from " << d1[i]
+                           << " to " << d2[i] << ":\n"
+                           << std::setprecision(16)
+                           << "    calculated: " << calculated[i] << "\n"
+                           << "    expected:   " << expected);
+        }
+
+        calculated = dayCounters[k].yearFractions(start, d2);
+        for (Size i=0; i<d1.size(); ++i) {
+            Time expected = dayCounters[k].yearFraction(start, d2[i]);
+            if (calculated[i] != expected)
+                BOOST_FAIL(dayCounters[k] << " from " << start
+                           << " to " << d2[i] << ":\n"
+                           << std::setprecision(16)
+                           << "    calculated: " << calculated[i] << "\n"
+                           << "    expected:   " << expected);
+        }
+
+        // reference periods are checked only when valid, since the
+        // single calculation might throw otherwise
+        for (Size i=0; i<d1.size(); ++i) {
+            Time expected;
+            try {
+                expected = dayCounters[k].yearFraction(d1[i], d2[i],
+                                                       refStart[i],
+                                                       refEnd[i]);
+            } catch (Error&) {
+                continue;
+            }
+            Time calculated = dayCounters[k].yearFractions(
+                                 std::vector<Date>(1, d1[i]),
+                                 std::vector<Date>(1, d2[i]),
+                                 std::vector<Date>(1, refStart[i]),
+                                 std::vector<Date>(1, refEnd[i]))[0];
+            if (calculated != expected)
+                BOOST_FAIL(dayCounters[k] << " from " << d1[i]
+                           << " to " << d2[i] << " with reference period "
+                           << refStart[i] << " to " << refEnd[i] << ":\n"
+                           << std::setprecision(16)
+                           << "    calculated: " << calculated << "\n"
+                           << "    expected:   " << expected);
+        }
+    }
+}
+
 
 test_suite* DayCounterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Day counter tests");
@@ -294,6 +400,7 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testSimple));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testOne));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252));
+    suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBatchYearFractions));
     return suite;
 }
 
@@ -31,6 +31,7 @@ class DayCounterTest {
     static void testSimple();
     static void testOne();
     static void testBusiness252();
+    static void testBatchYearFractions();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -386,6 +386,119 @@ void DefaultProbabilityCurveTest::testUpfrontBootstrap() {
         BOOST_ERROR("Cash-flow settings improperly modified");
 }
 
+void DefaultProbabilityCurveTest::testCdsHelperImpliedQuotes() {
+    BOOST_TEST_MESSAGE("Testing CDS helper quotes against engine results...");
+
+    SavedSettings backup;
+
+    Calendar calendar = TARGET();
+    Date today = calendar.adjust(Date::todaysDate());
+    Settings::instance().evaluationDate() = today;
+
+    Integer settlementDays = 1;
+    Rate runningSpread = 0.05;
+    Frequency frequency = Quarterly;
+    BusinessDayConvention convention = Following;
+    DateGeneration::Rule rule = DateGeneration::TwentiethIMM;
+    DayCounter dayCounter = Thirty360();
+    Real recoveryRate = 0.4;
+
+    RelinkableHandle<YieldTermStructure> discountCurve;
+    discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                                    new FlatForward(today,0.06,Actual360())));
+    boost::shared_ptr<SimpleQuote> hazardRate(new SimpleQuote(0.02));
+    boost::shared_ptr<DefaultProbabilityTermStructure> defaultCurve(
+                        new FlatHazardRate(today, Handle<Quote>(hazardRate),
+                                           Actual360()));
+    Handle<DefaultProbabilityTermStructure> probability(defaultCurve);
+
+    Integer n[] = { 1, 3, 5, 10 };
+    std::vector<boost::shared_ptr<SpreadCdsHelper> > spreadHelpers;
+    std::vector<boost::shared_ptr<UpfrontCdsHelper> > upfrontHelpers;
+    for (Size i=0; i<LENGTH(n); ++i) {
+        spreadHelpers.push_back(boost::shared_ptr<SpreadCdsHelper>(
+                    new SpreadCdsHelper(0.01, Period(n[i], Years),
+                                        settlementDays, calendar,
+                                        frequency, convention, rule,
+                                        dayCounter, recoveryRate,
+                                        discountCurve)));
+        spreadHelpers.back()->setTermStructure(defaultCurve.get());
+        upfrontHelpers.push_back(boost::shared_ptr<UpfrontCdsHelper>(
+                    new UpfrontCdsHelper(0.01, runningSpread,
+                                         Period(n[i], Years),
+                                         settlementDays, calendar,
+                                         frequency, convention, rule,
+                                         dayCounter, recoveryRate,
+                                         discountCurve, settlementDays)));
+        upfrontHelpers.back()->setTermStructure(defaultCurve.get());
+    }
+
+    Real tolerance = 1.0e-12;
+
+    for (Size k=0; k<3; ++k) {
+        // the helpers must notice changes in either curve
+        if (k == 1)
+            hazardRate->setValue(0.04);
+        if (k == 2)
+            discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                                    new FlatForward(today,0.03,Actual360())));
+
+        for (Size i=0; i<LENGTH(n); ++i) {
+            Date protectionStart = today + settlementDays;
+            Date startDate = calendar.adjust(protectionStart, convention);
+            Date endDate = today + n[i]*Years;
+            Schedule schedule = MakeSchedule().from(startDate)
+                                              .to(endDate)
+                                              .withFrequency(frequency)
+                                              .withCalendar(calendar)
+                                              .withConvention(convention)
+                                              .withTerminationDateConvention(
+                                                                   Unadjusted)
+                                              .withRule(rule);
+
+            CreditDefaultSwap runningCds(Protection::Buyer, 100.0, 0.01,
+                                         schedule, convention, dayCounter,
+                                         true, true, protectionStart);
+            runningCds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                           new MidPointCdsEngine(probability, recoveryRate,
+                                                 discountCurve)));
+
+            Rate expected = runningCds.fairSpread();
+            Rate calculated = spreadHelpers[i]->impliedQuote();
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce fair spread for "
+                            << n[i] << "Y credit-default swap"
+                            << std::setprecision(12)
+                            << "\n    helper: " << calculated
+                            << "\n    engine: " << expected);
+
+            {
+                SavedSettings backup;
+                Settings::instance().includeTodaysCashFlows() = true;
+
+                Date upfrontDate = calendar.advance(today, settlementDays,
+                                                    Days, convention);
+                CreditDefaultSwap upfrontCds(Protection::Buyer, 100.0, 0.01,
+                                             runningSpread, schedule,
+                                             convention, dayCounter,
+                                             true, true, protectionStart,
+                                             upfrontDate);
+                upfrontCds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                           new MidPointCdsEngine(probability, recoveryRate,
+                                                 discountCurve, true)));
+                expected = upfrontCds.fairUpfront();
+            }
+            calculated = upfrontHelpers[i]->impliedQuote();
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce fair upfront for "
+                            << n[i] << "Y credit-default swap"
+                            << std::setprecision(12)
+                            << "\n    helper: " << calculated
+                            << "\n    engine: " << expected);
+        }
+    }
+}
+
 
 test_suite* DefaultProbabilityCurveTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Default-probability curve tests");
@@ -405,5 +518,7 @@ test_suite* DefaultProbabilityCurveTest::suite() {
                 &DefaultProbabilityCurveTest::testSingleInstrumentBootstrap));
     suite->add(QUANTLIB_TEST_CASE(
                          &DefaultProbabilityCurveTest::testUpfrontBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &DefaultProbabilityCurveTest::testCdsHelperImpliedQuotes));
     return suite;
 }
@@ -27,6 +27,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -38,6 +39,9 @@
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
+#include <ql/timegrid.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
 #include <map>
@@ -1002,6 +1006,81 @@ void EuropeanOptionTest::testImpliedVolContainment() {
 }
 
 
+void EuropeanOptionTest::testBatchImpliedVol() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black formula and implied volatility...");
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 50.0, 80.0, 95.0, 99.5, 100.0, 100.5, 120.0, 200.0 };
+    Real forwards[] = { 80.0, 100.0, 130.0 };
+    Real stdDevs[] = { 0.01, 0.05, 0.2, 0.5, 1.0, 2.0, 4.0 };
+    Real discounts[] = { 0.5, 0.97, 1.0 };
+    Real displacements[] = { 0.0, 20.0 };
+
+    for (Size h=0; h<LENGTH(displacements); h++) {
+        Real displacement = displacements[h];
+
+        std::vector<Option::Type> optionTypes;
+        std::vector<Real> k, f, s, d;
+        for (Size i=0; i<LENGTH(types); i++)
+          for (Size j=0; j<LENGTH(strikes); j++)
+            for (Size l=0; l<LENGTH(forwards); l++)
+              for (Size m=0; m<LENGTH(stdDevs); m++)
+                for (Size n=0; n<LENGTH(discounts); n++) {
+                    // skip the cases where the price carries no
+                    // information on the volatility, i.e., deep in
+                    // the money options with negligible time value
+                    Real vega = blackFormulaStdDevDerivative(
+                                     strikes[j], forwards[l], stdDevs[m],
+                                     discounts[n], displacement);
+                    if (vega < 1.0e-4)
+                        continue;
+                    optionTypes.push_back(types[i]);
+                    k.push_back(strikes[j]);
+                    f.push_back(forwards[l]);
+                    s.push_back(stdDevs[m]);
+                    d.push_back(discounts[n]);
+                }
+        Array K(k.begin(), k.end()), F(f.begin(), f.end()),
+              S(s.begin(), s.end()), D(d.begin(), d.end());
+
+        Array prices = blackFormula(optionTypes, K, F, S, D, displacement);
+        Array implied = blackFormulaImpliedStdDev(optionTypes, K, F,
+                                                  prices, D, displacement,
+                                                  1.0e-10);
+
+        for (Size i=0; i<optionTypes.size(); i++) {
+            Real price = blackFormula(optionTypes[i], K[i], F[i], S[i],
+                                      D[i], displacement);
+            if (std::fabs(prices[i]-price) > 1.0e-12*price)
+                BOOST_FAIL("batch Black formula mismatch:"
+                           << "\n    type:       " << optionTypes[i]
+                           << "\n    strike:     " << K[i]
+                           << "\n    forward:    " << F[i]
+                           << "\n    std. dev.:  " << S[i]
+                           << "\n    batch:      " << prices[i]
+                           << "\n    single:     " << price);
+
+            Real single = blackFormulaImpliedStdDev(optionTypes[i], K[i],
+                                                    F[i], prices[i], D[i],
+                                                    displacement);
+            if (std::fabs(implied[i]-S[i]) > 1.0e-8
+                || std::fabs(implied[i]-single) > 1.0e-6)
+                BOOST_FAIL("batch implied std. dev. mismatch:"
+                           << "\n    type:         " << optionTypes[i]
+                           << "\n    strike:       " << K[i]
+                           << "\n    forward:      " << F[i]
+                           << "\n    discount:     " << D[i]
+                           << "\n    displacement: " << displacement
+                           << "\n    price:        " << prices[i]
+                           << "\n    std. dev.:    " << S[i]
+                           << "\n    batch:        " << implied[i]
+                           << "\n    single:       " << single);
+        }
+    }
+}
+
+
 // different engines
 
 namespace {
@@ -1478,8 +1557,39 @@ void EuropeanOptionTest::testLocalVolatility() {
     volTS->setInterpolation<Bicubic>();
     const boost::shared_ptr<GeneralizedBlackScholesProcess> process =
                                               makeProcess(s0, qTS, rTS,volTS);
+
+    const Handle<LocalVolTermStructure> localVol(
+        boost::shared_ptr<LocalVolTermStructure>(
+            new LocalVolSurface(Handle<BlackVolTermStructure>(volTS),
+                                Handle<YieldTermStructure>(rTS),
+                                Handle<YieldTermStructure>(qTS),
+                                Handle<Quote>(s0))));
+    // the grid must resolve the smile over the shortest maturity
+    std::vector<Real> logMoneyness(301);
+    for (Size k=0; k < logMoneyness.size(); ++k)
+        logMoneyness[k] = -1.5 + 0.01*k;
     
     for (Size i=2; i < dates.size(); ++i) {
+        // local vol sampled on the time grid of the engine
+        const TimeGrid timeGrid(process->time(dates[i]), 25);
+        const Handle<LocalVolTermStructure> griddedVol(
+            boost::shared_ptr<LocalVolTermStructure>(
+                new GriddedLocalVolSurface(
+                                localVol,
+                                Handle<YieldTermStructure>(rTS),
+                                Handle<YieldTermStructure>(qTS),
+                                Handle<Quote>(s0),
+                                std::vector<Time>(timeGrid.begin(),
+                                                  timeGrid.end()),
+                                logMoneyness)));
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>
+            griddedProcess(new GeneralizedBlackScholesProcess(
+                                         Handle<Quote>(s0),
+                                         Handle<YieldTermStructure>(qTS),
+                                         Handle<YieldTermStructure>(rTS),
+                                         Handle<BlackVolTermStructure>(volTS),
+                                         griddedVol));
+
         for (Size j=3; j < strikes.size()-5; j+=5) {
             const Date& exDate = dates[i];
             const boost::shared_ptr<StrikedTypePayoff> payoff(new
@@ -1541,6 +1651,21 @@ void EuropeanOptionTest::testLocalVolatility() {
                            << "\n    calculated: " << calculatedNPV
                            << "\n    expected:   " << expectedNPV);
             }
+
+            // same with the gridded local vol
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                    new FdBlackScholesVanillaEngine(griddedProcess, 25, 400, 0,
+                                                    FdmSchemeDesc::Douglas(),
+                                                    true, 0.35)));
+            calculatedNPV = option.NPV();
+            if (std::fabs(expectedNPV - calculatedNPV) > tol*expectedNPV) {
+                BOOST_FAIL("Failed to reproduce gridded local vol "
+                           << "option price for "
+                           << "\n    strike:     " << payoff->strike()
+                           << "\n    maturity:   " << exDate
+                           << "\n    calculated: " << calculatedNPV
+                           << "\n    expected:   " << expectedNPV);
+            }
         }
     }
 }
@@ -1554,6 +1679,7 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
                            &EuropeanOptionTest::testImpliedVolContainment));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testBatchImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testJRBinomialEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testCRRBinomialEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testEQPBinomialEngines));
@@ -33,6 +33,7 @@ class EuropeanOptionTest {
     static void testGreeks();
     static void testImpliedVol();
     static void testImpliedVolContainment();
+    static void testBatchImpliedVol();
     static void testJRBinomialEngines();
     static void testCRRBinomialEngines();
     static void testEQPBinomialEngines();
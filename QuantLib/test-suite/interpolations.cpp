@@ -28,6 +28,8 @@
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/math/interpolations/forwardflatinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation.hpp>
@@ -1644,6 +1646,124 @@ void InterpolationTest::testBicubicUpdate() {
     }
 }
 
+namespace {
+
+    void checkBatchValues(const std::string& name,
+                          const Interpolation& f,
+                          const Interpolation& reference,
+                          const Array& x) {
+        Array y;
+        f.values(x, y, true);
+        for (Size i=0; i<x.size(); ++i) {
+            Real expected = reference(x[i], true);
+            if (std::fabs(y[i]-expected) > 1.0e-12*std::fabs(expected)) {
+                BOOST_FAIL(name << " interpolation:"
+                           << "\n    x:          " << x[i]
+                           << "\n    batch:      " << y[i]
+                           << "\n    point-wise: " << expected);
+            }
+        }
+    }
+
+}
+
+void InterpolationTest::testBatchValues() {
+    BOOST_TEST_MESSAGE("Testing batch evaluation of interpolations...");
+
+    const Size n = 50, m = 1000;
+    std::vector<Real> x(n), y(n);
+    for (Size i=0; i<n; ++i) {
+        x[i] = 0.1*i*i;
+        y[i] = std::exp(-0.05*x[i]) + 0.1*std::sin(x[i]) + 0.2;
+    }
+
+    // sorted points, including the nodes and points outside the range
+    Array sorted(m);
+    Real xMin = x.front()-1.0, xMax = x.back()+1.0;
+    for (Size i=0; i<m; ++i)
+        sorted[i] = xMin + (xMax-xMin)*i/(m-1);
+    sorted[m/2] = x[n/2];
+    sorted[m/2+1] = x[n/2];
+    // the same points in scrambled order
+    Array scrambled(m);
+    for (Size i=0; i<m; ++i)
+        scrambled[i] = sorted[(37*i)%m];
+
+    // each interpolation is compared with a fresh copy, whose locate
+    // hint is not affected by the batch
+    LinearInterpolation linear1(x.begin(), x.end(), y.begin()),
+                        linear2(x.begin(), x.end(), y.begin());
+    CubicNaturalSpline cubic1(x.begin(), x.end(), y.begin()),
+                       cubic2(x.begin(), x.end(), y.begin());
+    BackwardFlatInterpolation backward1(x.begin(), x.end(), y.begin()),
+                              backward2(x.begin(), x.end(), y.begin());
+    ForwardFlatInterpolation forward1(x.begin(), x.end(), y.begin()),
+                             forward2(x.begin(), x.end(), y.begin());
+    LogLinearInterpolation log1(x.begin(), x.end(), y.begin()),
+                           log2(x.begin(), x.end(), y.begin());
+
+    for (Size k=0; k<2; ++k) {
+        const Array& points = (k == 0 ? sorted : scrambled);
+        checkBatchValues("linear", linear1, linear2, points);
+        checkBatchValues("cubic", cubic1, cubic2, points);
+        checkBatchValues("backward-flat", backward1, backward2, points);
+        checkBatchValues("forward-flat", forward1, forward2, points);
+        checkBatchValues("log-linear", log1, log2, points);
+    }
+
+    // scalar calls after a batch still locate the right interval
+    for (Size i=0; i<m; ++i) {
+        Real xi = scrambled[i];
+        Real expected = linear2(xi, true);
+        Real calculated = linear1(xi, true);
+        if (std::fabs(calculated-expected) > 1.0e-12*std::fabs(expected))
+            BOOST_FAIL("linear interpolation after batch:"
+                       << "\n    x:          " << xi
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+    }
+
+    // 2-D interpolations
+    Matrix z(n, n);
+    for (Size i=0; i<n; ++i)
+        for (Size j=0; j<n; ++j)
+            z[i][j] = y[j]*(1.0 + 0.01*x[i]);
+    BilinearInterpolation bilinear1(x.begin(), x.end(), x.begin(), x.end(), z),
+                          bilinear2(x.begin(), x.end(), x.begin(), x.end(), z);
+    BicubicSpline bicubic1(x.begin(), x.end(), x.begin(), x.end(), z),
+                  bicubic2(x.begin(), x.end(), x.begin(), x.end(), z);
+
+    // a grid of points, so that the x values repeat
+    const Size l = 20;
+    Array px(l*l), py(l*l), pz;
+    for (Size i=0; i<l; ++i) {
+        for (Size j=0; j<l; ++j) {
+            px[i*l+j] = x.front() + (x.back()-x.front())*i/(l-1);
+            py[i*l+j] = x.front() + (x.back()-x.front())*((7*j)%l)/(l-1);
+        }
+    }
+    bilinear1.values(px, py, pz);
+    for (Size i=0; i<px.size(); ++i) {
+        Real expected = bilinear2(px[i], py[i]);
+        if (std::fabs(pz[i]-expected) > 1.0e-12*std::fabs(expected))
+            BOOST_FAIL("bilinear interpolation:"
+                       << "\n    x:          " << px[i]
+                       << "\n    y:          " << py[i]
+                       << "\n    batch:      " << pz[i]
+                       << "\n    point-wise: " << expected);
+    }
+    bicubic1.values(px, py, pz);
+    for (Size i=0; i<px.size(); ++i) {
+        Real expected = bicubic2(px[i], py[i]);
+        if (std::fabs(pz[i]-expected) > 1.0e-12*std::fabs(expected))
+            BOOST_FAIL("bicubic spline:"
+                       << "\n    x:          " << px[i]
+                       << "\n    y:          " << py[i]
+                       << "\n    batch:      " << pz[i]
+                       << "\n    point-wise: " << expected);
+    }
+}
+
 namespace {
     Real f(Real h) {
         return std::pow( 1.0 + h, 1/h);
@@ -1716,6 +1836,7 @@ test_suite* InterpolationTest::suite() {
                               &InterpolationTest::testKernelInterpolation2D));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBicubicDerivatives));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBicubicUpdate));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBatchValues));
     suite->add(QUANTLIB_TEST_CASE(
                             &InterpolationTest::testRichardsonExtrapolation));
 
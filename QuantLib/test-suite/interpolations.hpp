@@ -47,6 +47,7 @@ class InterpolationTest {
     static void testKernelInterpolation2D();
     static void testBicubicDerivatives();
     static void testBicubicUpdate();
+    static void testBatchValues();
     static void testRichardsonExtrapolation();
 
     static boost::unit_test_framework::test_suite* suite();
@@ -468,6 +468,125 @@ void MatricesTest::testOrthogonalProjection() {
 
 }
 
+void MatricesTest::testLargeEigenvectors() {
+
+    BOOST_TEST_MESSAGE("Testing eigenvalues and eigenvectors "
+                       "of large matrices...");
+
+    MersenneTwisterUniformRng rng(42);
+    Size sizes[] = { 25, 60, 150 };
+
+    for (Size k=0; k<LENGTH(sizes); k++) {
+
+        Size n = sizes[k];
+        Matrix M(n, n);
+        for (Size i=0; i<n; i++)
+            for (Size j=0; j<=i; j++)
+                M[i][j] = M[j][i] = rng.next().value - 0.5;
+        // a repeated eigenvalue
+        Matrix D(n, n, 0.0);
+        for (Size i=0; i<n; i++)
+            D[i][i] = (i < n/3 ? 2.0 : Real(i));
+        Matrix testMatrices[] = { M, D };
+
+        for (Size l=0; l<LENGTH(testMatrices); l++) {
+            const Matrix& S = testMatrices[l];
+            SymmetricSchurDecomposition dec(S);
+            const Array& eigenValues = dec.eigenvalues();
+            const Matrix& eigenVectors = dec.eigenvectors();
+            Real tolerance = 1.0e-13 * n * norm(eigenValues);
+
+            for (Size i=0; i<n; i++) {
+                Array v(eigenVectors.column_begin(i),
+                        eigenVectors.column_end(i));
+                // check definition
+                if (norm(S*v - eigenValues[i]*v) > tolerance)
+                    BOOST_FAIL("Eigenvector definition not satisfied"
+                               << "\n    size:       " << n
+                               << "\n    eigenvalue: " << eigenValues[i]
+                               << "\n    error:      "
+                               << norm(S*v - eigenValues[i]*v));
+                // check decreasing ordering
+                if (i > 0 && eigenValues[i] > eigenValues[i-1])
+                    BOOST_FAIL("Eigenvalues not ordered"
+                               << "\n    size: " << n);
+                // check sign convention
+                if (v[0] < 0.0)
+                    BOOST_FAIL("Eigenvector with negative first element"
+                               << "\n    size: " << n);
+            }
+
+            // check normalization
+            Matrix m = transpose(eigenVectors) * eigenVectors;
+            Matrix id(n, n, 0.0);
+            for (Size i=0; i<n; i++)
+                id[i][i] = 1.0;
+            if (norm(m-id) > 1.0e-13 * n)
+                BOOST_FAIL("Eigenvectors not orthonormal"
+                           << "\n    size:  " << n
+                           << "\n    error: " << norm(m-id));
+        }
+    }
+}
+
+void MatricesTest::testProducts() {
+
+    BOOST_TEST_MESSAGE("Testing matrix products...");
+
+    MersenneTwisterUniformRng rng(42);
+    // larger than a block, and not a multiple of its size
+    Matrix A(150, 300), B(300, 170);
+    for (Size i=0; i<A.rows(); i++)
+        for (Size j=0; j<A.columns(); j++)
+            A[i][j] = rng.next().value - 0.5;
+    for (Size i=0; i<B.rows(); i++)
+        for (Size j=0; j<B.columns(); j++)
+            B[i][j] = rng.next().value - 0.5;
+
+    Real tolerance = 1.0e-12;
+    Matrix C = A*B;
+    for (Size i=0; i<C.rows(); i++) {
+        for (Size j=0; j<C.columns(); j++) {
+            Real expected = 0.0;
+            for (Size k=0; k<A.columns(); k++)
+                expected += A[i][k]*B[k][j];
+            if (std::fabs(C[i][j] - expected) > tolerance)
+                BOOST_FAIL("wrong matrix product"
+                           << "\n    element:    " << i << ", " << j
+                           << "\n    calculated: " << C[i][j]
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    Matrix T = transpose(B);
+    for (Size i=0; i<B.rows(); i++)
+        for (Size j=0; j<B.columns(); j++)
+            if (T[j][i] != B[i][j])
+                BOOST_FAIL("wrong transposed matrix");
+
+    Matrix S = symmetricProduct(A);
+    Matrix P = A*transpose(A);
+    for (Size i=0; i<S.rows(); i++)
+        for (Size j=0; j<S.columns(); j++)
+            if (std::fabs(S[i][j] - P[i][j]) > tolerance)
+                BOOST_FAIL("wrong symmetric product"
+                           << "\n    element:    " << i << ", " << j
+                           << "\n    calculated: " << S[i][j]
+                           << "\n    expected:   " << P[i][j]);
+
+    Array v(A.rows());
+    for (Size i=0; i<v.size(); i++)
+        v[i] = rng.next().value - 0.5;
+    Array w = v*A;
+    Array u = transpose(A)*v;
+    for (Size j=0; j<w.size(); j++)
+        if (std::fabs(w[j] - u[j]) > tolerance)
+            BOOST_FAIL("wrong vector-matrix product"
+                       << "\n    element:    " << j
+                       << "\n    calculated: " << w[j]
+                       << "\n    expected:   " << u[j]);
+}
+
 
 
 test_suite* MatricesTest::suite() {
@@ -475,6 +594,8 @@ test_suite* MatricesTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testOrthogonalProjection));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testEigenvectors));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testLargeEigenvectors));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testProducts));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSqrt));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSVD));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testHighamSqrt));
@@ -37,6 +37,8 @@
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/currencies/europe.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
@@ -425,12 +427,139 @@ void OvernightIndexedSwapTest::testBootstrap() {
 }
 
 
+namespace {
+
+    Rate expectedRate(const OvernightIndexedCoupon& coupon,
+                      const YieldTermStructure& curve) {
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Date>& valueDates = coupon.valueDates();
+        const std::vector<Time>& dt = coupon.dt();
+        Date today = Settings::instance().evaluationDate();
+        Real compound = 1.0;
+        Size i = 0;
+        for (; i<fixingDates.size() && fixingDates[i] < today; ++i)
+            compound *= 1.0 + coupon.index()->fixing(fixingDates[i])*dt[i];
+        // coupons entirely in the past have no forecast part
+        if (i < fixingDates.size())
+            compound *= curve.discount(valueDates[i]) /
+                        curve.discount(valueDates.back());
+        return (compound - 1.0) / coupon.accrualPeriod();
+    }
+
+}
+
+void OvernightIndexedSwapTest::testSeasonedCoupons() {
+
+    BOOST_TEST_MESSAGE("Testing seasoned overnight-indexed coupons...");
+
+    CommonVars vars;
+    vars.eoniaTermStructure.linkTo(flatRate(vars.today, 0.05,
+                                            Actual365Fixed()));
+
+    IndexManager::instance().clearHistories();
+
+    Date start = vars.calendar.advance(vars.today, -6, Months);
+    std::vector<shared_ptr<OvernightIndexedCoupon> > coupons;
+    for (Integer months = 3; months <= 12; months += 3) {
+        Date end = vars.calendar.advance(start, months, Months);
+        coupons.push_back(shared_ptr<OvernightIndexedCoupon>(
+            new OvernightIndexedCoupon(end, 100.0, start, end,
+                                       vars.eoniaIndex)));
+    }
+
+    std::vector<Date> dates;
+    std::vector<Real> fixings;
+    for (Date d = start - 10; d < vars.today; ++d) {
+        if (vars.eoniaIndex->isValidFixingDate(d)) {
+            dates.push_back(d);
+            fixings.push_back(0.01 + 0.0001*(d.dayOfMonth() % 7));
+        }
+    }
+    vars.eoniaIndex->addFixings(dates.begin(), dates.end(), fixings.begin());
+
+    Real tolerance = 1.0e-12;
+    for (Size step=0; step<3; ++step) {
+        switch (step) {
+          case 1:
+            // a new fixing is added and the evaluation date moves on
+            vars.eoniaIndex->addFixing(vars.today, 0.02);
+            Settings::instance().evaluationDate() =
+                vars.calendar.advance(vars.today, 1, Days);
+            break;
+          case 2:
+            // an old fixing is modified
+            vars.eoniaIndex->addFixing(dates[20], 0.03, true);
+            break;
+          default:
+            break;
+        }
+        for (Size i=0; i<coupons.size(); ++i) {
+            Rate calculated = coupons[i]->rate();
+            Rate expected = expectedRate(*coupons[i],
+                                         **vars.eoniaTermStructure);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce coupon rate:"
+                            << std::setprecision(12)
+                            << "\n    step:       " << step
+                            << "\n    start date: "
+                            << coupons[i]->accrualStartDate()
+                            << "\n    end date:   "
+                            << coupons[i]->accrualEndDate()
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // fixings at invalid dates, which might be stored when the
+    // history is set directly, are ignored
+    Settings::instance().evaluationDate() = vars.today;
+    shared_ptr<OvernightIndex> index(
+        new OvernightIndex("Test", 1, EURCurrency(), vars.calendar,
+                           Actual360(), vars.eoniaTermStructure));
+    TimeSeries<Real> history(dates.begin(), dates.end(), fixings.begin());
+    Date saturday = start;
+    while (saturday.weekday() != Saturday)
+        ++saturday;
+    history[saturday] = 0.5;
+    IndexManager::instance().setHistory(index->name(), history);
+    Date end = vars.calendar.advance(start, 9, Months);
+    OvernightIndexedCoupon coupon(end, 100.0, start, end, index);
+    Rate calculated = coupon.rate();
+    Rate expected = expectedRate(coupon, **vars.eoniaTermStructure);
+    if (std::fabs(calculated - expected) > tolerance)
+        BOOST_ERROR("failed to reproduce coupon rate "
+                    "with fixing at invalid date:"
+                    << std::setprecision(12)
+                    << "\n    invalid date: " << saturday
+                    << "\n    calculated:   " << calculated
+                    << "\n    expected:     " << expected);
+
+    // a missing fixing must still be detected
+    IndexManager::instance().clearHistories();
+    dates.erase(dates.begin() + 30);
+    fixings.erase(fixings.begin() + 30);
+    vars.eoniaIndex->addFixings(dates.begin(), dates.end(), fixings.begin());
+    bool failed = false;
+    try {
+        coupons.back()->rate();
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_ERROR("missing fixing not detected");
+
+    IndexManager::instance().clearHistories();
+}
+
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testCachedValue));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &OvernightIndexedSwapTest::testSeasonedCoupons));
     return suite;
 }
 
@@ -46,6 +46,7 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/experimental/risk/curvesensitivities.hpp>
 #include <iomanip>
 
 using namespace QuantLib;
@@ -906,6 +907,149 @@ void PiecewiseYieldCurveTest::testZeroCopy() {
 }
 
 
+namespace {
+
+    Real swapBookValue(const std::vector<boost::shared_ptr<VanillaSwap> >& s) {
+        Real value = 0.0;
+        for (Size i=0; i<s.size(); ++i)
+            value += s[i]->NPV();
+        return value;
+    }
+
+    template <class T, class I>
+    void checkQuoteSensitivities(CommonVars& vars, const std::string& name,
+                                 bool dualCurve = false) {
+
+        boost::shared_ptr<PiecewiseYieldCurve<T,I> > curve(
+            new PiecewiseYieldCurve<T,I>(vars.settlement, vars.instruments,
+                                         Actual360()));
+        vars.termStructure = curve;
+        Handle<YieldTermStructure> curveHandle(vars.termStructure);
+
+        // when dual-curve, the piecewise curve is only used for
+        // forecasting and the swaps are discounted on a flat curve
+        boost::shared_ptr<SimpleQuote> discountRate(new SimpleQuote(0.03));
+        boost::shared_ptr<YieldTermStructure> discountCurve =
+            vars.termStructure;
+        if (dualCurve)
+            discountCurve = boost::shared_ptr<YieldTermStructure>(
+                   new FlatForward(vars.settlement,
+                                   Handle<Quote>(discountRate), Actual360()));
+
+        boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(curveHandle));
+        Integer lengths[] = { 2, 7, 15 };
+        Rate fixedRates[] = { 0.04, 0.05, 0.06 };
+        VanillaSwap::Type types[] = {
+            VanillaSwap::Payer, VanillaSwap::Receiver, VanillaSwap::Payer
+        };
+        std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+        std::map<Date, Real> sensitivities, discountSensitivities;
+        for (Size i=0; i<LENGTH(lengths); ++i) {
+            boost::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(lengths[i]*Years, euribor6m, fixedRates[i])
+                .withType(types[i])
+                .withNominal(1000000.0)
+                .withEffectiveDate(vars.settlement)
+                .withFixedLegDayCount(vars.fixedLegDayCounter)
+                .withFixedLegTenor(Period(vars.fixedLegFrequency))
+                .withFixedLegConvention(vars.fixedLegConvention)
+                .withFixedLegTerminationDateConvention(
+                                                   vars.fixedLegConvention)
+                .withDiscountingTermStructure(
+                                  Handle<YieldTermStructure>(discountCurve));
+            swaps.push_back(swap);
+            Real sign = (types[i] == VanillaSwap::Payer ? 1.0 : -1.0);
+            if (dualCurve) {
+                addDiscountSensitivities(discountSensitivities, sensitivities,
+                                         swap->fixedLeg(), -sign,
+                                         discountCurve, vars.termStructure);
+                addDiscountSensitivities(discountSensitivities, sensitivities,
+                                         swap->floatingLeg(), sign,
+                                         discountCurve, vars.termStructure);
+            } else {
+                addDiscountSensitivities(sensitivities, swap->fixedLeg(),
+                                         -sign, vars.termStructure);
+                addDiscountSensitivities(sensitivities, swap->floatingLeg(),
+                                         sign, vars.termStructure);
+            }
+        }
+
+        std::vector<Real> calculated =
+            bucketSensitivities(sensitivities, *curve);
+
+        const std::vector<boost::shared_ptr<RateHelper> >& helpers =
+            curve->instruments();
+        if (calculated.size() != helpers.size())
+            BOOST_FAIL(name << ": wrong number of sensitivities:"
+                       << "\n    calculated: " << calculated.size()
+                       << "\n    expected:   " << helpers.size());
+
+        Real shift = 1.0e-6;
+        for (Size j=0; j<helpers.size(); ++j) {
+            boost::shared_ptr<SimpleQuote> quote =
+                boost::dynamic_pointer_cast<SimpleQuote>(
+                                          helpers[j]->quote().currentLink());
+            Real q = quote->value();
+            quote->setValue(q+shift);
+            Real up = swapBookValue(swaps);
+            quote->setValue(q-shift);
+            Real down = swapBookValue(swaps);
+            quote->setValue(q);
+            Real expected = (up-down)/(2.0*shift);
+
+            Real tolerance = 1.0e-4 * std::max(std::fabs(expected), 1.0e3);
+            if (std::fabs(calculated[j]-expected) > tolerance)
+                BOOST_ERROR(name << ": wrong sensitivity to the quote of "
+                            << io::ordinal(j+1) << " instrument (maturity: "
+                            << helpers[j]->latestDate() << ")"
+                            << QL_FIXED << std::setprecision(4)
+                            << "\n    calculated: " << calculated[j]
+                            << "\n    expected:   " << expected
+                            << "\n    tolerance:  " << tolerance);
+        }
+
+        if (dualCurve) {
+            // with continuous compounding, dP(d)/dr = -t(d) P(d)
+            Real calculated = 0.0;
+            std::map<Date, Real>::const_iterator i;
+            for (i=discountSensitivities.begin();
+                 i!=discountSensitivities.end(); ++i) {
+                calculated -= i->second
+                            * discountCurve->timeFromReference(i->first)
+                            * discountCurve->discount(i->first);
+            }
+
+            Real r = discountRate->value();
+            discountRate->setValue(r+shift);
+            Real up = swapBookValue(swaps);
+            discountRate->setValue(r-shift);
+            Real down = swapBookValue(swaps);
+            discountRate->setValue(r);
+            Real expected = (up-down)/(2.0*shift);
+
+            Real tolerance = 1.0e-4 * std::max(std::fabs(expected), 1.0e3);
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR(name << ": wrong sensitivity to the discount rate"
+                            << QL_FIXED << std::setprecision(4)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected
+                            << "\n    tolerance:  " << tolerance);
+        }
+    }
+
+}
+
+void PiecewiseYieldCurveTest::testQuoteSensitivities() {
+    BOOST_TEST_MESSAGE("Testing analytic sensitivities to curve quotes...");
+
+    CommonVars vars;
+    checkQuoteSensitivities<Discount,LogLinear>(vars, "log-linear discount");
+    checkQuoteSensitivities<ZeroYield,Linear>(vars, "linear zero");
+    checkQuoteSensitivities<ForwardRate,BackwardFlat>(vars, "flat forward");
+    checkQuoteSensitivities<Discount,LogLinear>(vars, "dual-curve", true);
+}
+
+
 
 
 test_suite* PiecewiseYieldCurveTest::suite() {
@@ -955,5 +1099,8 @@ test_suite* PiecewiseYieldCurveTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testForwardCopy));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testZeroCopy));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                       &PiecewiseYieldCurveTest::testQuoteSensitivities));
+
     return suite;
 }
@@ -74,12 +74,22 @@
 
 #include <ql/types.hpp>
 #include <ql/version.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/settings.hpp>
+#include <ql/math/matrixutilities/pseudosqrt.hpp>
+#include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/timer.hpp>
 #include <iostream>
 #include <iomanip>
 #include <list>
 #include <string>
+#include <new>
+#include <cstdlib>
 
 /* PAPI code
 #include <stdio.h
@@ -127,6 +137,81 @@
 using namespace boost::unit_test_framework;
 
 
+/* The memory used for loading trades is measured by replacing the
+   global allocation functions with versions keeping track of the
+   allocated bytes; the size of each block is stored in front of it.
+*/
+namespace {
+
+    union AllocationHeader {
+        std::size_t size;
+        // for alignment
+        long double ld;
+        void* p;
+    };
+
+    std::size_t allocatedBytes = 0;
+
+}
+
+// dynamic exception specifications are ill-formed in C++17
+#if __cplusplus < 201103L
+#define QL_BENCHMARK_THROWS_BAD_ALLOC throw (std::bad_alloc)
+#define QL_BENCHMARK_NOTHROW throw ()
+#else
+#define QL_BENCHMARK_THROWS_BAD_ALLOC
+#define QL_BENCHMARK_NOTHROW noexcept
+#endif
+
+void* operator new(std::size_t size) QL_BENCHMARK_THROWS_BAD_ALLOC {
+    void* p = std::malloc(size + sizeof(AllocationHeader));
+    if (!p)
+        throw std::bad_alloc();
+    static_cast<AllocationHeader*>(p)->size = size;
+    allocatedBytes += size;
+    return static_cast<AllocationHeader*>(p) + 1;
+}
+
+void operator delete(void* p) QL_BENCHMARK_NOTHROW {
+    if (p) {
+        AllocationHeader* h = static_cast<AllocationHeader*>(p) - 1;
+        allocatedBytes -= h->size;
+        std::free(h);
+    }
+}
+
+void* operator new(std::size_t size,
+                   const std::nothrow_t&) QL_BENCHMARK_NOTHROW {
+    try {
+        return operator new(size);
+    } catch (...) {
+        return 0;
+    }
+}
+
+void operator delete(void* p, const std::nothrow_t&) QL_BENCHMARK_NOTHROW {
+    operator delete(p);
+}
+
+void* operator new[](std::size_t size) QL_BENCHMARK_THROWS_BAD_ALLOC {
+    return operator new(size);
+}
+
+void operator delete[](void* p) QL_BENCHMARK_NOTHROW {
+    operator delete(p);
+}
+
+void* operator new[](std::size_t size,
+                     const std::nothrow_t& t) QL_BENCHMARK_NOTHROW {
+    return operator new(size, t);
+}
+
+void operator delete[](void* p,
+                       const std::nothrow_t& t) QL_BENCHMARK_NOTHROW {
+    operator delete(p, t);
+}
+
+
 namespace {
 
     class Benchmark {
@@ -216,6 +301,96 @@ namespace {
                   << sum/runTimes.size()
                   << " mflops" << std::endl;
     }
+
+    /* Builds a book of swaps on a common index and curves, as
+       done when loading trades, and reports the loading rate and the
+       memory taken by each trade.
+    */
+    void tradeLoading() {
+        using namespace QuantLib;
+
+        SavedSettings backup;
+        Date today(15, March, 2013);
+        Settings::instance().evaluationDate() = today;
+
+        Handle<YieldTermStructure> curve(
+            boost::shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.03, Actual365Fixed())));
+        boost::shared_ptr<IborIndex> index(new Euribor6M(curve));
+
+        const Size n = 20000;
+        std::vector<boost::shared_ptr<VanillaSwap> > book;
+        book.reserve(n);
+
+        std::size_t memory = allocatedBytes;
+        boost::timer timer;
+        for (Size i=0; i<n; ++i) {
+            Date start = today + Integer(i % 250);
+            book.push_back(MakeVanillaSwap(Period(1 + i%30, Years),
+                                           index, 0.03)
+                           .withEffectiveDate(start)
+                           .withDiscountingTermStructure(curve));
+        }
+        double elapsed = timer.elapsed();
+        memory = allocatedBytes - memory;
+
+        std::cout << std::string(56,'-') << std::endl
+                  << "Swap loading rate                         :"
+                  << std::fixed << std::setw(9) << std::setprecision(1)
+                  << n/elapsed << " trades/s" << std::endl
+                  << "Swap loading memory                       :"
+                  << std::fixed << std::setw(9) << std::setprecision(1)
+                  << double(memory)/n << " bytes/trade" << std::endl;
+    }
+
+    /* Times the matrix product, the symmetric eigenvalue problem and
+       the Higham-salvaged pseudo square root on correlation matrices
+       of increasing size.
+    */
+    void matrixKernels() {
+        using namespace QuantLib;
+
+        std::cout << std::string(56,'-') << std::endl;
+        Size sizes[] = { 50, 200, 500 };
+        for (Size s=0; s<LENGTH(sizes); ++s) {
+            const Size n = sizes[s];
+            // exponentially decaying correlations plus some noise,
+            // so that the matrix is not positive definite
+            MersenneTwisterUniformRng rng(42);
+            Matrix rho(n, n);
+            for (Size i=0; i<n; ++i) {
+                rho[i][i] = 1.0;
+                for (Size j=0; j<i; ++j)
+                    rho[i][j] = rho[j][i] =
+                        std::exp(-3.0*(i-j)/n)
+                        + 0.02*(rng.next().value-0.5);
+            }
+
+            const Size repetitions = 100000/(n*n) + 1;
+            boost::timer timer;
+            for (Size k=0; k<repetitions; ++k)
+                Matrix product = rho*rho;
+            double product = timer.elapsed()/repetitions;
+
+            timer.restart();
+            for (Size k=0; k<repetitions; ++k)
+                SymmetricSchurDecomposition jd(rho);
+            double eigen = timer.elapsed()/repetitions;
+
+            timer.restart();
+            for (Size k=0; k<repetitions; ++k)
+                Matrix root = pseudoSqrt(rho, SalvagingAlgorithm::Higham);
+            double higham = timer.elapsed()/repetitions;
+
+            std::cout << "Matrix kernels, n = " << std::setw(3) << n
+                      << "                   :"
+                      << std::fixed << std::setprecision(4)
+                      << std::setw(9) << product << " s (product), "
+                      << std::setw(9) << eigen << " s (eigen), "
+                      << std::setw(9) << higham << " s (Higham)"
+                      << std::endl;
+        }
+    }
 }
 
 #if defined(QL_ENABLE_SESSIONS)
@@ -291,6 +466,8 @@ test_suite* init_unit_test_suite(int, char*[]) {
     }
 
     test->add(QUANTLIB_TEST_CASE(printResults));
+    test->add(QUANTLIB_TEST_CASE(tradeLoading));
+    test->add(QUANTLIB_TEST_CASE(matrixKernels));
 
     return test;
 }
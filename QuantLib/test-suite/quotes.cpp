@@ -43,6 +43,27 @@ namespace {
     Real mul(Real x, Real y) { return x*y; }
     Real sub(Real x, Real y) { return x-y; }
 
+    // unregisters itself and another observer when notified
+    class Unregistering : public Observer {
+      public:
+        Unregistering(const boost::shared_ptr<Observable>& observable,
+                      Observer* other = 0)
+        : observable_(observable), other_(other), notifications_(0) {
+            registerWith(observable_);
+        }
+        void update() {
+            ++notifications_;
+            unregisterWith(observable_);
+            if (other_)
+                other_->unregisterWith(observable_);
+        }
+        Size notifications() const { return notifications_; }
+      private:
+        boost::shared_ptr<Observable> observable_;
+        Observer* other_;
+        Size notifications_;
+    };
+
 }
 
 
@@ -60,6 +81,129 @@ void QuoteTest::testObservable() {
 
 }
 
+void QuoteTest::testObserverRegistration() {
+
+    BOOST_TEST_MESSAGE("Testing registration and unregistration "
+                       "of observers...");
+
+    boost::shared_ptr<SimpleQuote> q1(new SimpleQuote(0.0)),
+                                   q2(new SimpleQuote(0.0));
+    const Size n = 100;
+    std::vector<boost::shared_ptr<Flag> > flags(n);
+    for (Size i=0; i<n; ++i) {
+        flags[i] = boost::shared_ptr<Flag>(new Flag);
+        flags[i]->registerWith(q1);
+        if (i % 2 == 0)
+            flags[i]->registerWith(q2);
+        // registering twice has no effect
+        if (flags[i]->registerWith(q1).second)
+            BOOST_FAIL("observer registered twice with the same quote");
+    }
+
+    // remove some observers in a different order than they registered
+    for (Size i=0; i<n; ++i) {
+        if (i % 3 == 0)
+            flags[n-1-i].reset();
+    }
+    for (Size i=0; i<n; i+=4) {
+        if (flags[i] && flags[i]->unregisterWith(q1) != 1)
+            BOOST_FAIL("observer " << i << " not unregistered");
+    }
+    // copies are registered with the same observables
+    Flag copy = *flags[1];
+
+    q1->setValue(1.0);
+    for (Size i=0; i<n; ++i) {
+        if (flags[i] && flags[i]->isUp() != (i % 4 != 0))
+            BOOST_FAIL("observer " << i << " wrongly notified:"
+                       << "\n    expected: " << (i % 4 != 0)
+                       << "\n    notified: " << flags[i]->isUp());
+    }
+    if (!copy.isUp())
+        BOOST_FAIL("copied observer not notified");
+
+    for (Size i=0; i<n; ++i) {
+        if (flags[i])
+            flags[i]->lower();
+    }
+    q2->setValue(1.0);
+    for (Size i=0; i<n; ++i) {
+        if (flags[i] && flags[i]->isUp() != (i % 2 == 0))
+            BOOST_FAIL("observer " << i << " wrongly notified:"
+                       << "\n    expected: " << (i % 2 == 0)
+                       << "\n    notified: " << flags[i]->isUp());
+    }
+
+    for (Size i=0; i<n; ++i) {
+        if (flags[i]) {
+            flags[i]->unregisterWithAll();
+            flags[i]->lower();
+        }
+    }
+    q1->setValue(2.0);
+    q2->setValue(2.0);
+    for (Size i=0; i<n; ++i) {
+        if (flags[i] && flags[i]->isUp())
+            BOOST_FAIL("observer " << i << " notified after unregistering");
+    }
+}
+
+void QuoteTest::testUnregistrationDuringNotification() {
+
+    BOOST_TEST_MESSAGE("Testing unregistration of observers "
+                       "during notification...");
+
+    boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.0));
+    const Size n = 10;
+    std::vector<boost::shared_ptr<Flag> > flags(n);
+    for (Size i=0; i<n; ++i) {
+        flags[i] = boost::shared_ptr<Flag>(new Flag);
+        flags[i]->registerWith(q);
+    }
+    // the second one is removed by the first one before its turn
+    Unregistering second(q);
+    Unregistering first(q, &second);
+    // the last flags registered are the ones that a swap with the
+    // last observer would move over the removed ones
+    std::vector<boost::shared_ptr<Flag> > lastFlags(n);
+    for (Size i=0; i<n; ++i) {
+        lastFlags[i] = boost::shared_ptr<Flag>(new Flag);
+        lastFlags[i]->registerWith(q);
+    }
+
+    q->setValue(1.0);
+    if (first.notifications() != 1)
+        BOOST_FAIL("unregistering observer notified "
+                   << first.notifications() << " times");
+    // observers are not notified in a given order, so the second
+    // one might or might not have been notified before being removed
+    if (second.notifications() > 1)
+        BOOST_FAIL("unregistered observer notified "
+                   << second.notifications() << " times");
+    for (Size i=0; i<n; ++i) {
+        if (!flags[i]->isUp() || !lastFlags[i]->isUp())
+            BOOST_FAIL("observer " << i << " skipped");
+        flags[i]->lower();
+        lastFlags[i]->lower();
+    }
+
+    // the registrations left are still consistent
+    Size notified = second.notifications();
+    for (Size i=0; i<n; i+=2)
+        flags[i]->unregisterWith(q);
+    q->setValue(2.0);
+    if (first.notifications() != 1 || second.notifications() != notified)
+        BOOST_FAIL("unregistered observer notified");
+    for (Size i=0; i<n; ++i) {
+        if (flags[i]->isUp() != (i % 2 != 0))
+            BOOST_FAIL("observer " << i << " wrongly notified:"
+                       << "\n    expected: " << (i % 2 != 0)
+                       << "\n    notified: " << flags[i]->isUp());
+        if (!lastFlags[i]->isUp())
+            BOOST_FAIL("observer " << i << " skipped");
+    }
+}
+
 void QuoteTest::testObservableHandle() {
 
     BOOST_TEST_MESSAGE("Testing observability of quote handles...");
@@ -199,6 +343,9 @@ void QuoteTest::testForwardValueQuoteAndImpliedStdevQuote(){
 test_suite* QuoteTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Quote tests");
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObservable));
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObserverRegistration));
+    suite->add(QUANTLIB_TEST_CASE(
+                      &QuoteTest::testUnregistrationDuringNotification));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObservableHandle));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testDerived));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testComposite));
@@ -28,6 +28,8 @@
 class QuoteTest {
   public:
     static void testObservable();
+    static void testObserverRegistration();
+    static void testUnregistrationDuringNotification();
     static void testObservableHandle();
     static void testDerived();
     static void testComposite();
@@ -20,8 +20,11 @@
 #include "schedule.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -138,6 +141,151 @@ void ScheduleTest::testDatesPastEndDateWithEomAdjustment() {
     check_dates(s, expected);
 }
 
+void ScheduleTest::testCachedSchedules() {
+    BOOST_TEST_MESSAGE("Testing cached schedules...");
+
+    ScheduleCache::instance().clear();
+
+    Date startDate = Date(17,January,2012);
+    MakeSchedule maker = MakeSchedule().from(startDate)
+                                       .to(startDate + 10*Years)
+                                       .withCalendar(TARGET())
+                                       .withFrequency(Semiannual)
+                                       .withConvention(ModifiedFollowing);
+
+    Schedule s = maker;
+    Schedule s1 = maker.cached();
+    Schedule s2 = maker.cached();
+    check_dates(s1, s.dates());
+    check_dates(s2, s.dates());
+    if (ScheduleCache::instance().size() != 1)
+        BOOST_FAIL(ScheduleCache::instance().size()
+                   << " schedules stored instead of 1");
+
+    boost::shared_ptr<const Schedule> p1 =
+        ScheduleCache::instance().schedule(startDate,
+                                           startDate + 10*Years,
+                                           Period(Semiannual), TARGET(),
+                                           ModifiedFollowing,
+                                           ModifiedFollowing,
+                                           DateGeneration::Backward,
+                                           false);
+    boost::shared_ptr<const Schedule> p2 =
+        ScheduleCache::instance().schedule(startDate,
+                                           startDate + 10*Years,
+                                           Period(Semiannual), Japan(),
+                                           ModifiedFollowing,
+                                           ModifiedFollowing,
+                                           DateGeneration::Backward,
+                                           false);
+    if (ScheduleCache::instance().size() != 2)
+        BOOST_FAIL(ScheduleCache::instance().size()
+                   << " schedules stored instead of 2");
+    check_dates(*p1, s.dates());
+
+    // cached schedules are shared, not copied
+    boost::shared_ptr<const Schedule> p3 = maker.cached().shared();
+    if (p3 != p1)
+        BOOST_FAIL("cached schedule not shared");
+
+    // changes in the holidays replace the schedules using the
+    // modified calendar, but not the others
+    Calendar calendar = TARGET();
+    Date holiday = s[1];
+    calendar.addHoliday(holiday);
+    Schedule s3 = maker.cached();
+    boost::shared_ptr<const Schedule> p6 =
+        ScheduleCache::instance().schedule(startDate,
+                                           startDate + 10*Years,
+                                           Period(Semiannual), Japan(),
+                                           ModifiedFollowing,
+                                           ModifiedFollowing,
+                                           DateGeneration::Backward,
+                                           false);
+    calendar.removeHoliday(holiday);
+    if (s3[1] == holiday)
+        BOOST_FAIL("added holiday not taken into account");
+    if (p6 != p2)
+        BOOST_FAIL("schedule with unchanged calendar not kept");
+    if (ScheduleCache::instance().size() != 2)
+        BOOST_FAIL(ScheduleCache::instance().size()
+                   << " schedules stored instead of 2");
+
+    // swaps with the same conventions share their schedules
+    boost::shared_ptr<IborIndex> index(new Euribor6M);
+    MakeVanillaSwap swapMaker =
+        MakeVanillaSwap(10*Years, index, 0.03)
+        .withEffectiveDate(startDate)
+        .withCachedSchedules();
+    VanillaSwap swap1 = swapMaker, swap2 = swapMaker;
+    if (&swap1.fixedSchedule() != &swap2.fixedSchedule()
+        || &swap1.floatingSchedule() != &swap2.floatingSchedule())
+        BOOST_FAIL("cached swap schedules not shared");
+    // the floating schedule has the same parameters as s3 and
+    // is shared with it, so only the fixed one is added
+    if (ScheduleCache::instance().size() != 3)
+        BOOST_FAIL(ScheduleCache::instance().size()
+                   << " schedules stored instead of 3");
+
+    // when the cache reaches its capacity, the least recently used
+    // schedule is discarded; here, the fixed one, since the floating
+    // one was used again after it.
+    Size capacity = ScheduleCache::instance().capacity();
+    ScheduleCache::instance().setCapacity(2);
+    boost::shared_ptr<const Schedule> p4 = maker.cached().shared();
+    boost::shared_ptr<const Schedule> p5 =
+        MakeSchedule(maker).withFrequency(Quarterly).cached().shared();
+    if (ScheduleCache::instance().size() != 2)
+        BOOST_FAIL(ScheduleCache::instance().size()
+                   << " schedules stored instead of 2");
+    if (maker.cached().shared() != p4)
+        BOOST_FAIL("recently used schedule discarded");
+    VanillaSwap swap3 = swapMaker;
+    if (&swap3.fixedSchedule() == &swap1.fixedSchedule())
+        BOOST_FAIL("least recently used schedule not discarded");
+    ScheduleCache::instance().setCapacity(capacity);
+
+    ScheduleCache::instance().clear();
+}
+
+void ScheduleTest::testBulkSchedules() {
+    BOOST_TEST_MESSAGE("Testing bulk schedule generation...");
+
+    MakeSchedule maker = MakeSchedule().withCalendar(TARGET())
+                                       .withFrequency(Quarterly)
+                                       .withConvention(ModifiedFollowing)
+                                       .endOfMonth();
+
+    std::vector<Date> startDates, endDates;
+    for (Date d(1,January,2012); d < Date(1,January,2013); d += 5) {
+        startDates.push_back(d);
+        endDates.push_back(d + 5*Years);
+        // duplicates are returned as well
+        startDates.push_back(d);
+        endDates.push_back(d + 5*Years);
+    }
+
+    for (Size k=0; k<2; ++k) {
+        std::vector<boost::shared_ptr<const Schedule> > schedules =
+            maker.cached(k == 1).schedules(startDates, endDates);
+        if (schedules.size() != startDates.size())
+            BOOST_FAIL(schedules.size() << " schedules returned instead of "
+                       << startDates.size());
+        for (Size i=0; i<startDates.size(); ++i) {
+            Schedule expected = MakeSchedule().from(startDates[i])
+                                              .to(endDates[i])
+                                              .withCalendar(TARGET())
+                                              .withFrequency(Quarterly)
+                                              .withConvention(
+                                                         ModifiedFollowing)
+                                              .endOfMonth();
+            check_dates(*schedules[i], expected.dates());
+        }
+    }
+
+    ScheduleCache::instance().clear();
+}
+
 
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
@@ -145,6 +293,8 @@ test_suite* ScheduleTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testEndDateWithEomAdjustment));
     suite->add(QUANTLIB_TEST_CASE(
                        &ScheduleTest::testDatesPastEndDateWithEomAdjustment));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testCachedSchedules));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testBulkSchedules));
     return suite;
 }
 
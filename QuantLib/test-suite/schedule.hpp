@@ -30,6 +30,8 @@ class ScheduleTest {
     static void testDailySchedule();
     static void testEndDateWithEomAdjustment();
     static void testDatesPastEndDateWithEomAdjustment();
+    static void testCachedSchedules();
+    static void testBulkSchedules();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -0,0 +1,151 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "settings.hpp"
+#include "utilities.hpp"
+#include <ql/settings.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/time/calendars/target.hpp>
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    #include <boost/thread/thread.hpp>
+    #include <boost/thread/barrier.hpp>
+    #include <sstream>
+#endif
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+void SettingsTest::testSavedSettings() {
+    BOOST_TEST_MESSAGE("Testing restoration of saved settings...");
+
+    Date today = Settings::instance().evaluationDate();
+    bool includeReferenceDateEvents =
+        Settings::instance().includeReferenceDateEvents();
+    bool enforcesTodaysHistoricFixings =
+        Settings::instance().enforcesTodaysHistoricFixings();
+    {
+        SavedSettings backup;
+        Settings::instance().evaluationDate() = today + 10;
+        Settings::instance().includeReferenceDateEvents() =
+            !includeReferenceDateEvents;
+        Settings::instance().enforcesTodaysHistoricFixings() =
+            !enforcesTodaysHistoricFixings;
+        if (Settings::instance().evaluationDate() != today + 10)
+            BOOST_FAIL("evaluation date not set:"
+                       << "\n    calculated: "
+                       << Settings::instance().evaluationDate()
+                       << "\n    expected:   " << today + 10);
+    }
+
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_ERROR("evaluation date not restored:"
+                    << "\n    calculated: "
+                    << Settings::instance().evaluationDate()
+                    << "\n    expected:   " << today);
+    if (Settings::instance().includeReferenceDateEvents() !=
+        includeReferenceDateEvents)
+        BOOST_ERROR("reference-date events flag not restored");
+    if (Settings::instance().enforcesTodaysHistoricFixings() !=
+        enforcesTodaysHistoricFixings)
+        BOOST_ERROR("historic-fixings flag not restored");
+}
+
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+
+namespace {
+
+    class Session {
+      public:
+        Session(const Date& today, Real fixing,
+                boost::barrier& barrier, std::string& error)
+        : today_(today), fixing_(fixing), barrier_(barrier), error_(error) {}
+        void operator()() {
+            try {
+                Settings::instance().evaluationDate() = today_;
+                boost::shared_ptr<IborIndex> index(new Euribor6M);
+                Date fixingDate = index->fixingCalendar().advance(today_,
+                                                                  -1*Days);
+                index->addFixing(fixingDate, fixing_);
+
+                // the other session sets its own data in the meantime...
+                barrier_.wait();
+
+                // ...which must not be seen from this one.
+                std::ostringstream out;
+                if (Settings::instance().evaluationDate() != today_)
+                    out << "\n    evaluation date: "
+                        << Settings::instance().evaluationDate()
+                        << " instead of " << today_;
+                if (index->timeSeries().size() != 1)
+                    out << "\n    " << index->timeSeries().size()
+                        << " fixings stored instead of 1";
+                if (index->fixing(fixingDate) != fixing_)
+                    out << "\n    fixing: " << index->fixing(fixingDate)
+                        << " instead of " << fixing_;
+
+                // the business-day tables are shared among sessions
+                Calendar calendar = TARGET(), compiled = TARGET();
+                compiled.compile();
+                for (Date d = today_ - 100; d < today_ + 100; ++d) {
+                    if (compiled.advance(d, 10, Days) !=
+                        calendar.advance(d, 10, Days))
+                        out << "\n    wrong business day after " << d;
+                }
+                error_ = out.str();
+            } catch (std::exception& e) {
+                error_ = std::string("\n    ") + e.what();
+            }
+        }
+      private:
+        Date today_;
+        Real fixing_;
+        boost::barrier& barrier_;
+        std::string& error_;
+    };
+
+}
+
+void SettingsTest::testThreadLocalSessions() {
+    BOOST_TEST_MESSAGE("Testing isolation of thread-local sessions...");
+
+    boost::barrier barrier(2);
+    std::string error1, error2;
+    boost::thread session1(Session(Date(15, March, 2010), 0.01,
+                                   barrier, error1));
+    boost::thread session2(Session(Date(17, May, 2011), 0.02,
+                                   barrier, error2));
+    session1.join();
+    session2.join();
+
+    if (!error1.empty())
+        BOOST_ERROR("first session:" << error1);
+    if (!error2.empty())
+        BOOST_ERROR("second session:" << error2);
+}
+
+#endif
+
+
+test_suite* SettingsTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Settings tests");
+    suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testSavedSettings));
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testThreadLocalSessions));
+    #endif
+    return suite;
+}
+
@@ -26,6 +26,9 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -119,6 +122,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingStatistics>(std::string("StreamingStatistics"));
 }
 
 
@@ -322,12 +326,89 @@ void StatisticsTest::testConvergenceStatistics() {
 }
 
 
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing streaming quantile estimation...");
+
+    MersenneTwisterUniformRng rng(42);
+    InverseCumulativeNormal invCumNormal;
+
+    RiskStatistics exact;
+    StreamingRiskStatistics streaming, even, odd;
+    const Size N = 100000;
+    for (Size i=0; i<N; ++i) {
+        // skewed, so that the tails are not symmetric
+        Real x = invCumNormal(rng.next().value);
+        x += 0.1*x*x;
+        exact.add(x);
+        streaming.add(x);
+        if (i % 2 == 0)
+            even.add(x);
+        else
+            odd.add(x);
+    }
+    StreamingRiskStatistics merged = even;
+    merged.merge(odd);
+
+    if (merged.samples() != N)
+        BOOST_FAIL("wrong number of samples after merge"
+                   << "\n    calculated: " << merged.samples()
+                   << "\n    expected:   " << N);
+    if (merged.min() != exact.min() || merged.max() != exact.max())
+        BOOST_FAIL("wrong extremes after merge"
+                   << "\n    calculated: " << merged.min()
+                   << ", " << merged.max()
+                   << "\n    expected:   " << exact.min()
+                   << ", " << exact.max());
+    if (std::fabs(merged.mean() - exact.mean()) > 1.0e-10)
+        BOOST_FAIL("wrong mean after merge"
+                   << "\n    calculated: " << merged.mean()
+                   << "\n    expected:   " << exact.mean());
+
+    // the rank of the estimate must be within the documented bound
+    Real q[] = { 0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999 };
+    for (Size i=0; i<LENGTH(q); ++i) {
+        Real bound = 2.0*M_PI*std::sqrt(q[i]*(1.0-q[i]))
+                   / streaming.compression();
+        Real lower = exact.percentile(std::max(q[i]-bound, 1.0/N));
+        Real upper = exact.percentile(std::min(q[i]+bound, 1.0));
+        Real calculated[] = { streaming.percentile(q[i]),
+                              merged.percentile(q[i]) };
+        for (Size j=0; j<LENGTH(calculated); ++j) {
+            if (calculated[j] < lower || calculated[j] > upper)
+                BOOST_FAIL("percentile out of bounds"
+                           << (j == 0 ? "" : " after merge")
+                           << "\n    percentile: " << q[i]
+                           << "\n    calculated: " << calculated[j]
+                           << "\n    bounds:     [" << lower
+                           << ", " << upper << "]");
+        }
+    }
+
+    Real tolerance = 0.01;
+    Real expected = exact.valueAtRisk(0.99);
+    Real calculated = merged.valueAtRisk(0.99);
+    if (std::fabs(calculated-expected) > tolerance*expected)
+        BOOST_FAIL("wrong value-at-risk"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+
+    expected = exact.expectedShortfall(0.99);
+    calculated = merged.expectedShortfall(0.99);
+    if (std::fabs(calculated-expected) > tolerance*expected)
+        BOOST_FAIL("wrong expected shortfall"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+}
+
+
 
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
     return suite;
 }
 
@@ -31,6 +31,7 @@ class StatisticsTest {
     static void testStatistics();
     static void testSequenceStatistics();
     static void testConvergenceStatistics();
+    static void testStreamingStatistics();
     static boost::unit_test_framework::test_suite* suite();
 };
 
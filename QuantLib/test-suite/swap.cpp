@@ -21,8 +21,13 @@
 #include "utilities.hpp"
 #include <ql/instruments/vanillaswap.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/swap/discountingswapportfolio.hpp>
+#include <ql/experimental/risk/scenarioengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
@@ -35,6 +40,7 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/currencies/europe.hpp>
+#include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -99,6 +105,65 @@ namespace {
         }
     };
 
+    // builds a set of swaps forecasting on a curve and discounting
+    // on another; both are flat and quoted
+    class SwapPortfolioBuilder : public ScenarioEngine::Builder {
+      public:
+        // the calendar is shared by all the copies
+        explicit SwapPortfolioBuilder(const Calendar& calendar = TARGET())
+        : calendar_(calendar) {}
+        ScenarioEngine::Portfolio build() const {
+            ScenarioEngine::Portfolio portfolio;
+            boost::shared_ptr<SimpleQuote> forecastRate(
+                                                  new SimpleQuote(0.05));
+            boost::shared_ptr<SimpleQuote> discountRate(
+                                                  new SimpleQuote(0.04));
+            portfolio.quotes.push_back(forecastRate);
+            portfolio.quotes.push_back(discountRate);
+
+            const Calendar& calendar = calendar_;
+            Date today = Settings::instance().evaluationDate();
+            Date settlement = calendar.advance(today, 2, Days);
+            Handle<YieldTermStructure> forecastCurve(
+                        flatRate(settlement, forecastRate, Actual365Fixed()));
+            Handle<YieldTermStructure> discountCurve(
+                        flatRate(settlement, discountRate, Actual365Fixed()));
+            boost::shared_ptr<IborIndex> index(
+                                   new Euribor(6*Months, forecastCurve));
+            boost::shared_ptr<PricingEngine> engine(
+                                   new DiscountingSwapEngine(discountCurve));
+
+            Integer lengths[] = { 1, 2, 5, 10, 20 };
+            VanillaSwap::Type types[] = { VanillaSwap::Payer,
+                                          VanillaSwap::Receiver };
+            for (Size i=0; i<LENGTH(lengths); ++i) {
+                // the last one is seasoned, and its first coupon
+                // has a past fixing
+                Date start = (i == LENGTH(lengths)-1) ?
+                    calendar.advance(today, -4, Months) :
+                    settlement;
+                Date maturity = calendar.advance(start, lengths[i], Years,
+                                                 ModifiedFollowing);
+                Schedule fixedSchedule(start, maturity, 1*Years, calendar,
+                                       Unadjusted, Unadjusted,
+                                       DateGeneration::Forward, false);
+                Schedule floatSchedule(start, maturity, 6*Months, calendar,
+                                       ModifiedFollowing, ModifiedFollowing,
+                                       DateGeneration::Forward, false);
+                boost::shared_ptr<VanillaSwap> swap(
+                    new VanillaSwap(types[i%2], 100.0,
+                                    fixedSchedule, 0.045, Thirty360(),
+                                    floatSchedule, index, 0.001,
+                                    index->dayCounter()));
+                swap->setPricingEngine(engine);
+                portfolio.instruments.push_back(swap);
+            }
+            return portfolio;
+        }
+      private:
+        Calendar calendar_;
+    };
+
 }
 
 
@@ -322,6 +387,360 @@ void SwapTest::testCachedValue() {
                     << "    expected:   " << cachedNPV);
 }
 
+void SwapTest::testForecastCache() {
+
+    BOOST_TEST_MESSAGE("Testing memoized index forecasts...");
+
+    CommonVars vars;
+
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.05));
+    vars.termStructure.linkTo(flatRate(vars.settlement, rate,
+                                       Actual365Fixed()));
+
+    boost::shared_ptr<VanillaSwap> swap = vars.makeSwap(10, 0.06, 0.001);
+    const Leg& leg = swap->floatingLeg();
+
+    for (Size k=0; k<3; ++k) {
+        switch (k) {
+          case 0:
+            break;
+          case 1:
+            rate->setValue(0.04);
+            break;
+          case 2:
+            vars.termStructure.linkTo(flatRate(vars.settlement, 0.07,
+                                               Actual365Fixed()));
+            break;
+        }
+
+        for (Size i=0; i<leg.size(); ++i) {
+            boost::shared_ptr<FloatingRateCoupon> coupon =
+                boost::dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+            Date fixingDate = coupon->fixingDate();
+            Date d1 = vars.index->valueDate(fixingDate);
+            Date d2 = vars.index->maturityDate(d1);
+            Time t = vars.index->dayCounter().yearFraction(d1, d2);
+            Rate expected = (vars.termStructure->discount(d1) /
+                             vars.termStructure->discount(d2) - 1.0) / t;
+            // twice, so that the second call hits the memo
+            for (Size j=0; j<2; ++j) {
+                Rate calculated = vars.index->fixing(fixingDate);
+                if (std::fabs(calculated - expected) > 1.0e-15)
+                    BOOST_FAIL("wrong forecast fixing:"
+                               << "\n    curve:      " << k
+                               << "\n    fixing:     " << fixingDate
+                               << QL_FIXED << std::setprecision(12)
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << expected);
+            }
+        }
+
+        // same swap on a fresh index, without any memoized value
+        boost::shared_ptr<IborIndex> index = vars.index;
+        vars.index = vars.index->clone(vars.termStructure);
+        boost::shared_ptr<VanillaSwap> fresh = vars.makeSwap(10, 0.06, 0.001);
+        vars.index = index;
+
+        if (std::fabs(swap->NPV() - fresh->NPV()) > 1.0e-10)
+            BOOST_FAIL("swap value not updated after curve change:"
+                       << "\n    curve:      " << k
+                       << QL_FIXED << std::setprecision(12)
+                       << "\n    calculated: " << swap->NPV()
+                       << "\n    expected:   " << fresh->NPV());
+    }
+}
+
+void SwapTest::testEvaluationDateNotifications() {
+
+    BOOST_TEST_MESSAGE("Testing notifications of evaluation-date changes...");
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+    // needed when the first fixing date is in the past
+    vars.index->addFixing(vars.today, 0.05);
+
+    boost::shared_ptr<VanillaSwap> swap = vars.makeSwap(10, 0.06, 0.001);
+    const Leg& leg = swap->floatingLeg();
+    std::vector<boost::shared_ptr<NotificationCounter> > counters;
+    for (Size i=0; i<leg.size(); ++i) {
+        counters.push_back(boost::shared_ptr<NotificationCounter>(
+                                                  new NotificationCounter));
+        counters.back()->registerWith(leg[i]);
+    }
+    NotificationCounter indexCounter, swapCounter;
+    indexCounter.registerWith(vars.index);
+    swapCounter.registerWith(swap);
+
+    Date today = vars.today;
+    for (Size k=1; k<=3; ++k) {
+        swap->NPV();
+
+        today = vars.calendar.advance(today, 1, Days);
+        Settings::instance().evaluationDate() = today;
+
+        // the swap observes the evaluation date directly...
+        if (swapCounter.count() != k)
+            BOOST_FAIL("wrong number of notifications from swap:"
+                       << "\n    date changes: " << k
+                       << "\n    expected:     " << k
+                       << "\n    received:     " << swapCounter.count());
+        // ...and the change doesn't go through the index and coupons
+        if (indexCounter.count() != 0)
+            BOOST_FAIL("unexpected notifications from index:"
+                       << "\n    date changes: " << k
+                       << "\n    received:     " << indexCounter.count());
+        for (Size i=0; i<counters.size(); ++i) {
+            if (counters[i]->count() != 0)
+                BOOST_FAIL("unexpected notifications from coupon " << i
+                           << ":\n    date changes: " << k
+                           << "\n    received:     "
+                           << counters[i]->count());
+        }
+    }
+
+    // other changes still go through the coupons
+    vars.termStructure.linkTo(flatRate(vars.settlement, 0.04,
+                                       Actual365Fixed()));
+    for (Size i=0; i<counters.size(); ++i) {
+        if (counters[i]->count() != 1)
+            BOOST_FAIL("wrong number of notifications from coupon " << i
+                       << " after curve change:"
+                       << "\n    expected: 1"
+                       << "\n    received: " << counters[i]->count());
+    }
+}
+
+void SwapTest::testPortfolio() {
+
+    BOOST_TEST_MESSAGE("Testing portfolio valuation of vanilla swaps...");
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.05));
+    vars.termStructure.linkTo(flatRate(vars.settlement, rate,
+                                       Actual365Fixed()));
+    RelinkableHandle<YieldTermStructure> discountCurve(
+                       flatRate(vars.settlement, 0.04, Actual365Fixed()));
+
+    VanillaSwap::Type types[] = { VanillaSwap::Payer, VanillaSwap::Receiver };
+    Integer lengths[] = { 1, 2, 5, 10, 20 };
+    Rate fixedRates[] = { 0.03, 0.06 };
+    Spread spreads[] = { -0.001, 0.0, 0.002 };
+
+    DiscountingSwapPortfolio portfolio;
+    std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+
+    for (Size i=0; i<LENGTH(types); i++) {
+        vars.type = types[i];
+        for (Size j=0; j<LENGTH(lengths); j++) {
+            for (Size k=0; k<LENGTH(fixedRates); k++) {
+                for (Size l=0; l<LENGTH(spreads); l++) {
+                    boost::shared_ptr<VanillaSwap> swap =
+                        vars.makeSwap(lengths[j],fixedRates[k],spreads[l]);
+                    if (l % 2 == 0) {
+                        portfolio.add(swap, vars.termStructure);
+                    } else {
+                        swap->setPricingEngine(
+                            boost::shared_ptr<PricingEngine>(
+                                   new DiscountingSwapEngine(discountCurve)));
+                        portfolio.add(swap, discountCurve);
+                    }
+                    swaps.push_back(swap);
+                }
+            }
+        }
+    }
+
+    // a seasoned swap, whose first coupon has a past fixing
+    Date settlement = vars.settlement;
+    vars.settlement = vars.calendar.advance(vars.today, -4, Months);
+    boost::shared_ptr<VanillaSwap> seasoned = vars.makeSwap(5, 0.05, 0.001);
+    vars.settlement = settlement;
+    boost::shared_ptr<FloatingRateCoupon> first =
+        boost::dynamic_pointer_cast<FloatingRateCoupon>(
+                                              seasoned->floatingLeg()[0]);
+    vars.index->addFixing(first->fixingDate(), 0.045);
+    portfolio.add(seasoned, vars.termStructure);
+    swaps.push_back(seasoned);
+
+    for (Size n=0; n<3; ++n) {
+        switch (n) {
+          case 0:
+            break;
+          case 1:
+            rate->setValue(0.055);
+            break;
+          case 2:
+            discountCurve.linkTo(flatRate(vars.settlement, 0.045,
+                                          Actual365Fixed()));
+            break;
+        }
+
+        for (Size i=0; i<swaps.size(); ++i) {
+            const VanillaSwap& swap = *swaps[i];
+            Real calculated[] = {
+                portfolio.NPV()[i],
+                portfolio.fixedLegNPV()[i],
+                portfolio.floatingLegNPV()[i],
+                portfolio.fixedLegBPS()[i],
+                portfolio.floatingLegBPS()[i],
+                portfolio.fairRate()[i],
+                portfolio.fairSpread()[i]
+            };
+            Real expected[] = {
+                swap.NPV(),
+                swap.fixedLegNPV(),
+                swap.floatingLegNPV(),
+                swap.fixedLegBPS(),
+                swap.floatingLegBPS(),
+                swap.fairRate(),
+                swap.fairSpread()
+            };
+            std::string labels[] = {
+                "NPV", "fixed-leg NPV", "floating-leg NPV",
+                "fixed-leg BPS", "floating-leg BPS",
+                "fair rate", "fair spread"
+            };
+            for (Size j=0; j<LENGTH(labels); ++j) {
+                if (std::fabs(calculated[j] - expected[j]) > 1.0e-12)
+                    BOOST_FAIL("wrong portfolio " << labels[j] << ":"
+                               << "\n    scenario:   " << n
+                               << "\n    swap:       " << i
+                               << QL_SCIENTIFIC << std::setprecision(15)
+                               << "\n    calculated: " << calculated[j]
+                               << "\n    expected:   " << expected[j]);
+            }
+        }
+    }
+}
+
+
+namespace {
+
+    void checkScenarioEngine(const Calendar& calendar,
+                             const std::vector<Size>& workers) {
+
+        Date today = calendar.adjust(Date::todaysDate());
+        Settings::instance().evaluationDate() = today;
+
+        boost::shared_ptr<SwapPortfolioBuilder> builder(
+                                          new SwapPortfolioBuilder(calendar));
+
+        // fixing for the seasoned swap
+        ScenarioEngine::Portfolio reference = builder->build();
+        boost::shared_ptr<VanillaSwap> seasoned =
+            boost::dynamic_pointer_cast<VanillaSwap>(
+                                              reference.instruments.back());
+        boost::shared_ptr<FloatingRateCoupon> first =
+            boost::dynamic_pointer_cast<FloatingRateCoupon>(
+                                                  seasoned->floatingLeg()[0]);
+        seasoned->iborIndex()->addFixing(first->fixingDate(), 0.045);
+
+        Real shifts[][2] = {
+            {  0.0,     0.0    },
+            {  0.0001,  0.0    },
+            {  0.0,     0.0001 },
+            { -0.0001, -0.0001 },
+            {  0.01,    0.005  },
+            { -0.02,   -0.01   },
+            {  0.0,     0.0    }
+        };
+        Size scenarios = LENGTH(shifts);
+        Matrix scenarioShifts(scenarios, 2);
+        for (Size i=0; i<scenarios; ++i)
+            std::copy(shifts[i], shifts[i]+2, scenarioShifts.row_begin(i));
+
+        std::vector<Real> baseNPVs(reference.instruments.size());
+        for (Size k=0; k<baseNPVs.size(); ++k)
+            baseNPVs[k] = reference.instruments[k]->NPV();
+
+        for (Size w=0; w<workers.size(); ++w) {
+            ScenarioEngine engine(builder, workers[w]);
+            Matrix results = engine.results(scenarioShifts);
+
+            if (results.rows() != scenarios
+                || results.columns() != reference.instruments.size())
+                BOOST_FAIL("wrong size of results:"
+                           << "\n    workers:    " << workers[w]
+                           << "\n    calculated: " << results.rows()
+                           << " x " << results.columns()
+                           << "\n    expected:   " << scenarios
+                           << " x " << reference.instruments.size());
+
+            for (Size i=0; i<scenarios; ++i) {
+                reference.quotes[0]->setValue(0.05 + shifts[i][0]);
+                reference.quotes[1]->setValue(0.04 + shifts[i][1]);
+                for (Size k=0; k<reference.instruments.size(); ++k) {
+                    Real expected =
+                        reference.instruments[k]->NPV() - baseNPVs[k];
+                    Real calculated = results[i][k];
+                    if (std::fabs(calculated - expected) > 1.0e-12)
+                        BOOST_FAIL("wrong change in NPV:"
+                                   << "\n    workers:    " << workers[w]
+                                   << "\n    scenario:   " << i
+                                   << "\n    swap:       " << k
+                                   << QL_SCIENTIFIC << std::setprecision(15)
+                                   << "\n    calculated: " << calculated
+                                   << "\n    expected:   " << expected);
+                }
+            }
+            reference.quotes[0]->setValue(0.05);
+            reference.quotes[1]->setValue(0.04);
+        }
+    }
+
+}
+
+
+void SwapTest::testScenarioEngine() {
+
+    BOOST_TEST_MESSAGE("Testing scenario analysis of vanilla swaps...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    // a single worker evaluates the scenarios in the calling thread
+    checkScenarioEngine(TARGET(), std::vector<Size>(1, 1));
+
+    #if !defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    // more workers would run in separate threads sharing the settings
+    boost::shared_ptr<ScenarioEngine::Builder> builder(
+                                                 new SwapPortfolioBuilder);
+    bool failed = false;
+    try {
+        ScenarioEngine engine(builder, 3);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_FAIL("several workers accepted "
+                   "without thread-local sessions");
+    #endif
+}
+
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+void SwapTest::testThreadedScenarioEngine() {
+
+    BOOST_TEST_MESSAGE("Testing scenario analysis in separate threads...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    // the copies share a compiled calendar, whose table of
+    // business days is built by the first thread using it
+    Calendar calendar = JointCalendar(TARGET(),
+                                      UnitedKingdom(UnitedKingdom::Exchange));
+    calendar.compile();
+
+    std::vector<Size> workers;
+    workers.push_back(2);
+    workers.push_back(4);
+    workers.push_back(7);
+    checkScenarioEngine(calendar, workers);
+}
+#endif
+
 
 test_suite* SwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swap tests");
@@ -331,6 +750,13 @@ test_suite* SwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSpreadDependency));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testInArrears));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testForecastCache));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testEvaluationDateNotifications));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testPortfolio));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testScenarioEngine));
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testThreadedScenarioEngine));
+    #endif
     return suite;
 }
 
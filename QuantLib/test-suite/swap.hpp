@@ -21,6 +21,7 @@
 #define quantlib_test_swap_hpp
 
 #include <boost/test/unit_test.hpp>
+#include <ql/qldefines.hpp>
 
 /* remember to document new and/or updated tests in the Doxygen
    comment block of the corresponding class */
@@ -33,6 +34,13 @@ class SwapTest {
     static void testSpreadDependency();
     static void testInArrears();
     static void testCachedValue();
+    static void testForecastCache();
+    static void testEvaluationDateNotifications();
+    static void testPortfolio();
+    static void testScenarioEngine();
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    static void testThreadedScenarioEngine();
+    #endif
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -23,6 +23,8 @@
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #if BOOST_VERSION >= 103600
     #include <boost/unordered_map.hpp>
 #endif
@@ -189,11 +191,147 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testInsertion() {
+    BOOST_TEST_MESSAGE("Testing insertion into time series...");
+
+    TimeSeries<Real> ts;
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Integer i=0; i<100; ++i) {
+        dates.push_back(Date(1, January, 2010) + 2*i);
+        values.push_back(i);
+    }
+    // sorted dates appended at the end...
+    ts.insert(dates.begin(), dates.begin()+50, values.begin());
+    ts.insert(dates.begin()+50, dates.end(), values.begin()+50);
+    // ...and unsorted ones, partly overwriting the existing data
+    std::vector<Date> moreDates;
+    std::vector<Real> moreValues;
+    moreDates.push_back(dates[10] + 1);
+    moreValues.push_back(-1.0);
+    moreDates.push_back(dates[5]);
+    moreValues.push_back(-2.0);
+    moreDates.push_back(dates[0] - 1);
+    moreValues.push_back(-3.0);
+    ts.insert(moreDates.begin(), moreDates.end(), moreValues.begin());
+
+    if (ts.size() != 102)
+        BOOST_FAIL(ts.size() << " data stored instead of 102");
+    for (Size i=0; i<dates.size(); ++i) {
+        Real expected = (i == 5 ? -2.0 : values[i]);
+        if (ts[dates[i]] != expected)
+            BOOST_ERROR("wrong value stored at " << dates[i] << ": "
+                        << ts[dates[i]] << " instead of " << expected);
+    }
+    if (ts[dates[10] + 1] != -1.0 || ts[dates[0] - 1] != -3.0)
+        BOOST_ERROR("wrong values stored at unsorted dates");
+    if (ts.firstDate() != dates[0] - 1 || ts.lastDate() != dates.back())
+        BOOST_ERROR("wrong first or last date");
+    const TimeSeries<Real>& cts = ts;
+    if (cts[dates[0] + 1] != Null<Real>() || ts.size() != 102)
+        BOOST_ERROR("missing datum not returned as null");
+}
+
+void TimeSeriesTest::testIndexHistory() {
+    BOOST_TEST_MESSAGE("Testing bulk storage of index fixings...");
+
+    IndexManager::instance().clearHistories();
+
+    boost::shared_ptr<IborIndex> index(new Euribor6M);
+    Flag flag;
+    flag.registerWith(index);
+
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Date d(1, January, 2010); d < Date(1, January, 2011); ++d) {
+        if (index->isValidFixingDate(d)) {
+            dates.push_back(d);
+            values.push_back(0.01 + d.dayOfYear()*1.0e-5);
+        }
+    }
+
+    index->addFixings(dates.begin(), dates.end(), values.begin());
+    if (!flag.isUp())
+        BOOST_FAIL("observer not notified of added fixings");
+
+    const TimeSeries<Real>& history = index->timeSeries();
+    if (history.size() != dates.size())
+        BOOST_FAIL(history.size() << " fixings stored instead of "
+                   << dates.size());
+    for (Size i=0; i<dates.size(); ++i) {
+        if (index->fixing(dates[i]) != values[i])
+            BOOST_ERROR("wrong fixing at " << dates[i] << ": "
+                        << index->fixing(dates[i]) << " instead of "
+                        << values[i]);
+    }
+
+    // the same fixings can be added again...
+    flag.lower();
+    index->addFixings(dates.begin(), dates.end(), values.begin());
+    if (!flag.isUp())
+        BOOST_FAIL("observer not notified of added fixings");
+
+    // ...but not different ones, unless overwriting is forced
+    Real newFixing = values[3] + 0.01;
+    bool failed = false;
+    try {
+        index->addFixing(dates[3], newFixing);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_FAIL("duplicated fixing accepted");
+    if (index->fixing(dates[3]) != values[3])
+        BOOST_FAIL("duplicated fixing stored");
+    index->addFixing(dates[3], newFixing, true);
+    if (index->fixing(dates[3]) != newFixing)
+        BOOST_FAIL("fixing not overwritten");
+
+    // duplicated dates in the same batch are checked against each
+    // other even when they're not consecutive
+    index->clearFixings();
+    std::vector<Date> batchDates(3);
+    std::vector<Real> batchValues(3);
+    batchDates[0] = dates[5]; batchValues[0] = values[5];
+    batchDates[1] = dates[1]; batchValues[1] = values[1];
+    batchDates[2] = dates[5]; batchValues[2] = values[5];
+    index->addFixings(batchDates.begin(), batchDates.end(),
+                      batchValues.begin());
+    if (index->timeSeries().size() != 2)
+        BOOST_FAIL(index->timeSeries().size()
+                   << " fixings stored instead of 2");
+
+    index->clearFixings();
+    batchValues[2] = values[5] + 0.01;
+    failed = false;
+    try {
+        index->addFixings(batchDates.begin(), batchDates.end(),
+                          batchValues.begin());
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_FAIL("conflicting fixings in the same batch accepted");
+    if (index->fixing(dates[5]) != values[5])
+        BOOST_FAIL("conflicting fixing stored");
+
+    // when overwriting is forced, the last one wins
+    index->addFixings(batchDates.begin(), batchDates.end(),
+                      batchValues.begin(), true);
+    if (index->fixing(dates[5]) != batchValues[2])
+        BOOST_FAIL("last fixing in the batch not stored");
+
+    IndexManager::instance().clearHistories();
+}
+
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testInsertion));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIndexHistory));
     return suite;
 }
 
@@ -21,6 +21,7 @@
 #define quantlib_test_time_series_hpp
 
 #include <boost/test/unit_test.hpp>
+#include <ql/qldefines.hpp>
 
 /* remember to document new and/or updated tests in the Doxygen
    comment block of the corresponding class */
@@ -30,6 +31,8 @@ class TimeSeriesTest {
     static void testConstruction();
     static void testIntervalPrice();
     static void testIterators();
+    static void testInsertion();
+    static void testIndexHistory();
     static boost::unit_test_framework::test_suite* suite();
     
 };
@@ -154,6 +154,16 @@ namespace QuantLib {
         void update() { raise(); }
     };
 
+    class NotificationCounter : public QuantLib::Observer {
+      private:
+        QuantLib::Size count_;
+      public:
+        NotificationCounter() : count_(0) {}
+        void reset() { count_ = 0; }
+        QuantLib::Size count() const { return count_; }
+        void update() { ++count_; }
+    };
+
     template<class Iterator>
     Real norm(const Iterator& begin, const Iterator& end, Real h) {
         // squared values